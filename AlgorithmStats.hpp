@@ -0,0 +1,180 @@
+#ifndef ALGORITHM_STATS_HPP
+#define ALGORITHM_STATS_HPP
+
+#include <bits/stdc++.h>
+using namespace std;
+
+// Events counted by the instrumented algorithms.
+enum class StatCounter {
+    HeapPushes,       // dijkstra: queue pushes
+    HeapPops,         // dijkstra: queue pops, stale ones included
+    StalePops,        // dijkstra: pops of entries whose distance was improved since
+    ArcScans,         // arcs examined by dijkstra, bellmanFord and the flow searches
+    Relaxations,      // bellmanFord: distance improvements
+    Passes,           // bellmanFord: passes over all arcs
+    BfsPhases,        // Dinic level graphs and edmondsKarp searches
+    AugmentingPaths,  // Dinic and edmondsKarp: paths flow was pushed along
+    DsuFinds,         // kruskal: disjoint-set finds
+    DsuUnions,        // kruskal: unions, i.e. tree edges
+};
+
+const int STAT_COUNTER_COUNT = 10;
+const char* const STAT_COUNTER_NAMES[STAT_COUNTER_COUNT] = {
+    "heap_pushes", "heap_pops", "stale_pops", "arc_scans", "relaxations",
+    "passes", "bfs_phases", "augmenting_paths", "dsu_finds", "dsu_unions",
+};
+
+// -----------------------------------------------------------------------------
+// Optional instrumentation. The instrumented overloads of dijkstra(), bellmanFord(),
+// edmondsKarp() and kruskal() take an AlgorithmStats<Enabled>&, and BasicDinic a
+// Stats class parameter. NullStats (Enabled = false) has only empty inline members,
+// so an algorithm run with it compiles to the uninstrumented code; the overloads
+// without stats use it. TraceStats (Enabled = true) counts events and records timed
+// phases.
+//
+// Phases nest: every beginPhase() is closed by an endPhase(), and a recorded phase
+// keeps its start, duration, depth and the counter increments made while it was
+// open. writeChromeTrace() exports the phases as Chrome trace-event JSON, which
+// chrome://tracing and Perfetto show as a flame chart. A TraceStats object must be
+// used by one thread at a time; parallel sections are counted by the calling thread.
+// -----------------------------------------------------------------------------
+template <bool Enabled>
+class AlgorithmStats {
+  public:
+    struct Phase {
+        const char* name;
+        double startUs;  // since the stats object was created or reset
+        double durationUs;
+        int depth;
+        array<long long, STAT_COUNTER_COUNT> counters;
+    };
+
+    AlgorithmStats() {
+        reset();
+    }
+
+    void count(StatCounter counter, long long amount = 1) {
+        counters_[static_cast<int>(counter)] += amount;
+    }
+
+    void beginPhase(const char* name) {
+        Phase phase = {name, elapsedUs(), 0, static_cast<int>(open_.size()), counters_};
+        open_.push_back(phases_.size());
+        phases_.push_back(phase);
+    }
+
+    void endPhase() {
+        Phase& phase = phases_[open_.back()];
+        open_.pop_back();
+        phase.durationUs = elapsedUs() - phase.startUs;
+        for (int i = 0; i < STAT_COUNTER_COUNT; i++) {
+            phase.counters[i] = counters_[i] - phase.counters[i];
+        }
+    }
+
+    long long counter(StatCounter counter) const {
+        return counters_[static_cast<int>(counter)];
+    }
+
+    const vector<Phase>& phases() const {
+        return phases_;
+    }
+
+    void reset() {
+        counters_.fill(0);
+        phases_.clear();
+        open_.clear();
+        origin_ = chrono::steady_clock::now();
+    }
+
+    // The non-zero counters, then the number and total time of the phases per name.
+    // The formatting of out is restored afterwards.
+    void print(ostream& out) const {
+        ios::fmtflags flags = out.flags();
+        streamsize precision = out.precision();
+        for (int i = 0; i < STAT_COUNTER_COUNT; i++) {
+            if (counters_[i] != 0) {
+                out << "  " << left << setw(20) << STAT_COUNTER_NAMES[i] << right << setw(16) << counters_[i] << "\n";
+            }
+        }
+        vector<pair<string, pair<long long, double>>> totals;
+        for (const Phase& phase : phases_) {
+            auto it = find_if(totals.begin(), totals.end(),
+                              [&](const pair<string, pair<long long, double>>& t) { return t.first == phase.name; });
+            if (it == totals.end()) {
+                totals.push_back({phase.name, {0, 0.0}});
+                it = totals.end() - 1;
+            }
+            it->second.first++;
+            it->second.second += phase.durationUs;
+        }
+        for (const auto& total : totals) {
+            out << "  phase " << left << setw(14) << total.first << right << setw(10) << total.second.first
+                << " x " << fixed << setprecision(3) << setw(12) << total.second.second / 1000 << " ms\n";
+        }
+        out.flags(flags);
+        out.precision(precision);
+    }
+
+    // Chrome trace-event JSON: one complete ("X") event per phase with its counters
+    // as arguments.
+    void writeChromeTrace(ostream& out) const {
+        ios::fmtflags flags = out.flags();
+        streamsize precision = out.precision();
+        out << "{\"displayTimeUnit\": \"ms\", \"traceEvents\": [";
+        for (size_t i = 0; i < phases_.size(); i++) {
+            const Phase& phase = phases_[i];
+            out << (i ? "," : "") << "\n  {\"name\": \"" << phase.name << "\", \"cat\": \"algorithm\", \"ph\": \"X\""
+                << ", \"pid\": 1, \"tid\": 1, \"ts\": " << fixed << setprecision(3) << phase.startUs
+                << ", \"dur\": " << phase.durationUs << ", \"args\": {";
+            bool first = true;
+            for (int c = 0; c < STAT_COUNTER_COUNT; c++) {
+                if (phase.counters[c] != 0) {
+                    out << (first ? "" : ", ") << "\"" << STAT_COUNTER_NAMES[c] << "\": " << phase.counters[c];
+                    first = false;
+                }
+            }
+            out << "}}";
+        }
+        out << "\n]}\n";
+        out.flags(flags);
+        out.precision(precision);
+    }
+
+    void saveChromeTrace(const string& path) const {
+        ofstream out(path);
+        if (!out) {
+            throw runtime_error("Cannot open " + path + " for writing!");
+        }
+        writeChromeTrace(out);
+    }
+
+  private:
+    array<long long, STAT_COUNTER_COUNT> counters_;
+    vector<Phase> phases_;
+    vector<size_t> open_;  // indices of the phases not yet ended
+    chrono::steady_clock::time_point origin_;
+
+    double elapsedUs() const {
+        return chrono::duration<double, micro>(chrono::steady_clock::now() - origin_).count();
+    }
+};
+
+template <>
+class AlgorithmStats<false> {
+  public:
+    void count(StatCounter, long long = 1) {}
+    void beginPhase(const char*) {}
+    void endPhase() {}
+};
+
+typedef AlgorithmStats<false> NullStats;
+typedef AlgorithmStats<true> TraceStats;
+
+// Shared instance for the overloads without stats; NullStats has no state.
+inline NullStats& nullStats() {
+    static NullStats stats;
+    return stats;
+}
+
+#endif // ALGORITHM_STATS_HPP
@@ -0,0 +1,490 @@
+#ifndef ALL_PAIRS_SHORTEST_PATHS_HPP
+#define ALL_PAIRS_SHORTEST_PATHS_HPP
+
+#include "CsrGraph.hpp"
+#include "DijkstraAlgorithm.hpp"
+#include "BellmanFordAlgorithm.hpp"
+#include "ThreadPool.hpp"
+#include <bits/stdc++.h>
+#include <fcntl.h>
+#include <sys/mman.h>
+#include <sys/stat.h>
+#include <unistd.h>
+#ifdef __AVX2__
+#include <immintrin.h>
+#endif
+
+// Side of the square tiles of BlockedDistanceMatrix. Three 64 x 64 tiles of ints
+// (48 KB) fit in L2 for the min-plus kernels, and a tile row of one vertex is 256
+// bytes.
+const int DISTANCE_TILE = 64;
+
+// Distance matrix file: a DistanceFileHeader, padding up to DISTANCE_FILE_DATA_OFFSET
+// so that the tiles start page-aligned, then the tiles in native byte order.
+const char DISTANCE_FILE_MAGIC[4] = {'G', 'R', 'D', 'M'};
+const uint32_t DISTANCE_FILE_VERSION = 1;
+const size_t DISTANCE_FILE_DATA_OFFSET = 4096;
+
+struct DistanceFileHeader {
+    char magic[4];
+    uint32_t version;
+    int32_t vertexCount;
+    int32_t tile;
+};
+
+// Graphs with at most this many vertices and at least n^2 / FLOYD_WARSHALL_DENSITY arcs
+// are solved by allPairsShortestPaths() with Floyd-Warshall instead of Johnson.
+const int FLOYD_WARSHALL_MAX_VERTICES = 4096;
+const int FLOYD_WARSHALL_DENSITY = 8;
+
+// -----------------------------------------------------------------------------
+// n x n matrix of shortest distances, 1-indexed like the vector of dijkstra(), with
+// INF for unreachable pairs. It is stored as DISTANCE_TILE x DISTANCE_TILE tiles,
+// each row-major and contiguous, with the tiles in row-major order; the vertex range
+// is padded to whole tiles with INF entries. The min-plus kernels of Floyd-Warshall
+// work on three tiles at a time, and Johnson fills one tile row (DISTANCE_TILE
+// sources) per task, so both touch whole tiles.
+//
+// The matrix lives in memory, or in a file mapped with MAP_SHARED: the kernel then
+// pages it to and from disk, so the matrix may exceed RAM, and the finished file can
+// be reopened with open() without reading it.
+// -----------------------------------------------------------------------------
+class BlockedDistanceMatrix {
+  public:
+    explicit BlockedDistanceMatrix(int vertexCount = 0) : data_(nullptr), mapping_(nullptr), mappingSize_(0) {
+        setSize(vertexCount);
+        memory_.assign(entryCount(), INF);
+        data_ = memory_.data();
+    }
+
+    // Creates the file path (truncating an existing one) and keeps the matrix in it.
+    BlockedDistanceMatrix(int vertexCount, const string& path) : data_(nullptr), mapping_(nullptr), mappingSize_(0) {
+        setSize(vertexCount);
+        mapFile(path, true);
+        fill(data_, data_ + entryCount(), INF);
+    }
+
+    // Maps a matrix file written before; changes are written back to the file.
+    static BlockedDistanceMatrix open(const string& path) {
+        BlockedDistanceMatrix matrix;
+        matrix.mapFile(path, false);
+        return matrix;
+    }
+
+    BlockedDistanceMatrix(BlockedDistanceMatrix&& other) noexcept : data_(nullptr), mapping_(nullptr), mappingSize_(0) {
+        swap(other);
+    }
+
+    BlockedDistanceMatrix& operator=(BlockedDistanceMatrix&& other) noexcept {
+        swap(other);
+        return *this;
+    }
+
+    BlockedDistanceMatrix(const BlockedDistanceMatrix&) = delete;
+    BlockedDistanceMatrix& operator=(const BlockedDistanceMatrix&) = delete;
+
+    ~BlockedDistanceMatrix() {
+        if (mapping_ != nullptr) {
+            munmap(mapping_, mappingSize_);
+        }
+    }
+
+    int vertexCount() const { return vertexCount_; }
+    // Tiles per side.
+    int tileCount() const { return tiles_; }
+    bool isMapped() const { return mapping_ != nullptr; }
+
+    int* tile(int bi, int bj) {
+        return data_ + (static_cast<size_t>(bi) * tiles_ + bj) * DISTANCE_TILE * DISTANCE_TILE;
+    }
+
+    const int* tile(int bi, int bj) const {
+        return data_ + (static_cast<size_t>(bi) * tiles_ + bj) * DISTANCE_TILE * DISTANCE_TILE;
+    }
+
+    int at(int u, int v) const {
+        return data_[index(u - 1, v - 1)];
+    }
+
+    void set(int u, int v, int distance) {
+        data_[index(u - 1, v - 1)] = distance;
+    }
+
+    // The distances from u in the layout of dijkstra(): n + 1 entries, entry 0 unused.
+    vector<int> row(int u) const {
+        vector<int> dist(vertexCount_ + 1, INF);
+        for (int bj = 0; bj < tiles_; bj++) {
+            const int* in = tile((u - 1) / DISTANCE_TILE, bj) + (u - 1) % DISTANCE_TILE * DISTANCE_TILE;
+            int count = min(DISTANCE_TILE, vertexCount_ - bj * DISTANCE_TILE);
+            copy(in, in + count, dist.begin() + 1 + bj * DISTANCE_TILE);
+        }
+        return dist;
+    }
+
+    // Stores dist[1..n] as the distances from u.
+    void setRow(int u, const int* dist) {
+        for (int bj = 0; bj < tiles_; bj++) {
+            int* out = tile((u - 1) / DISTANCE_TILE, bj) + (u - 1) % DISTANCE_TILE * DISTANCE_TILE;
+            int count = min(DISTANCE_TILE, vertexCount_ - bj * DISTANCE_TILE);
+            copy(dist + 1 + bj * DISTANCE_TILE, dist + 1 + bj * DISTANCE_TILE + count, out);
+        }
+    }
+
+    // Writes the changes of a mapped matrix to its file before returning.
+    void sync() {
+        if (mapping_ != nullptr && msync(mapping_, mappingSize_, MS_SYNC) != 0) {
+            throw runtime_error("Cannot write the distance matrix file!");
+        }
+    }
+
+  private:
+    int vertexCount_;
+    int tiles_;
+    int* data_;
+    vector<int> memory_;
+    char* mapping_;
+    size_t mappingSize_;
+
+    void setSize(int vertexCount) {
+        if (vertexCount < 0) {
+            throw runtime_error("Negative vertex count!");
+        }
+        vertexCount_ = vertexCount;
+        tiles_ = (vertexCount + DISTANCE_TILE - 1) / DISTANCE_TILE;
+    }
+
+    size_t entryCount() const {
+        return static_cast<size_t>(tiles_) * tiles_ * DISTANCE_TILE * DISTANCE_TILE;
+    }
+
+    size_t index(int i, int j) const {
+        return (static_cast<size_t>(i / DISTANCE_TILE) * tiles_ + j / DISTANCE_TILE) * DISTANCE_TILE * DISTANCE_TILE +
+               i % DISTANCE_TILE * DISTANCE_TILE + j % DISTANCE_TILE;
+    }
+
+    void mapFile(const string& path, bool create) {
+        int fd = ::open(path.c_str(), create ? O_RDWR | O_CREAT | O_TRUNC : O_RDWR, 0644);
+        if (fd < 0) {
+            throw runtime_error("Cannot open " + path + "!");
+        }
+        DistanceFileHeader header;
+        if (create) {
+            copy(DISTANCE_FILE_MAGIC, DISTANCE_FILE_MAGIC + 4, header.magic);
+            header.version = DISTANCE_FILE_VERSION;
+            header.vertexCount = vertexCount_;
+            header.tile = DISTANCE_TILE;
+            mappingSize_ = DISTANCE_FILE_DATA_OFFSET + entryCount() * sizeof(int);
+            if (ftruncate(fd, mappingSize_) != 0) {
+                close(fd);
+                throw runtime_error("Cannot resize " + path + "!");
+            }
+        } else {
+            struct stat info;
+            if (pread(fd, &header, sizeof(header), 0) != static_cast<ssize_t>(sizeof(header)) ||
+                !equal(header.magic, header.magic + 4, DISTANCE_FILE_MAGIC)) {
+                close(fd);
+                throw runtime_error(path + " is not a distance matrix file!");
+            }
+            if (header.version != DISTANCE_FILE_VERSION || header.tile != DISTANCE_TILE || header.vertexCount < 0) {
+                close(fd);
+                throw runtime_error("Unsupported distance matrix version in " + path + "!");
+            }
+            setSize(header.vertexCount);
+            mappingSize_ = DISTANCE_FILE_DATA_OFFSET + entryCount() * sizeof(int);
+            if (fstat(fd, &info) != 0 || static_cast<size_t>(info.st_size) != mappingSize_) {
+                close(fd);
+                throw runtime_error("Truncated distance matrix file " + path + "!");
+            }
+        }
+        void* mapping = mmap(nullptr, mappingSize_, PROT_READ | PROT_WRITE, MAP_SHARED, fd, 0);
+        close(fd);
+        if (mapping == MAP_FAILED) {
+            throw runtime_error("Cannot map " + path + "!");
+        }
+        mapping_ = static_cast<char*>(mapping);
+        if (create) {
+            memcpy(mapping_, &header, sizeof(header));
+        }
+        data_ = reinterpret_cast<int*>(mapping_ + DISTANCE_FILE_DATA_OFFSET);
+    }
+
+    void swap(BlockedDistanceMatrix& other) {
+        std::swap(vertexCount_, other.vertexCount_);
+        std::swap(tiles_, other.tiles_);
+        std::swap(data_, other.data_);
+        memory_.swap(other.memory_);
+        std::swap(mapping_, other.mapping_);
+        std::swap(mappingSize_, other.mappingSize_);
+    }
+};
+
+// Johnson's potentials: the distances from a virtual source joined to every vertex by
+// a zero-weight arc, from one bellmanFordQueue() run over the graph extended by that
+// source. Every arc u -> v of weight w then has w + p[u] - p[v] >= 0. Throws if the
+// graph has a negative cycle; a negative undirected edge is one.
+inline vector<int> johnsonPotentials(const CsrGraph& graph) {
+    int n = graph.vertexCount;
+    int m = graph.arcCount();
+    CsrGraph extended;
+    extended.vertexCount = n + 1;
+    extended.isDirected = true;
+    extended.minWeight = min(graph.minWeight, 0);
+    extended.maxWeight = max(graph.maxWeight, 0);
+    extended.offsets.reserve(n + 3);
+    extended.offsets.assign(graph.offsets.begin(), graph.offsets.end());
+    extended.offsets.push_back(m + n);
+    extended.targets.reserve(m + n);
+    extended.targets.assign(graph.targets.begin(), graph.targets.end());
+    extended.weights.reserve(m + n);
+    extended.weights.assign(graph.weights.begin(), graph.weights.end());
+    for (int v = 1; v <= n; v++) {
+        extended.targets.push_back(v);
+        extended.weights.push_back(0);
+    }
+    BellmanFordResult result = bellmanFordQueue(extended, n + 1);
+    if (result.hasNegativeCycle) {
+        throw runtime_error("Negative cycle!");
+    }
+    result.dist.pop_back();
+    return result.dist;
+}
+
+// The graph with every arc u -> v reweighted to w + potential[u] - potential[v].
+inline CsrGraph reweightedCsrGraph(const CsrGraph& graph, const vector<int>& potential) {
+    CsrGraph reweighted = graph;
+    int maxWeight = 0;
+    for (int u = 1; u <= graph.vertexCount; u++) {
+        for (int a = graph.offsets[u]; a < graph.offsets[u + 1]; a++) {
+            long long weight = static_cast<long long>(graph.weights[a]) + potential[u] - potential[graph.targets[a]];
+            if (weight < 0 || weight >= INF) {
+                throw runtime_error("Reweighted arc out of range!");
+            }
+            reweighted.weights[a] = static_cast<int>(weight);
+            maxWeight = max(maxWeight, static_cast<int>(weight));
+        }
+    }
+    reweighted.minWeight = 0;
+    reweighted.maxWeight = maxWeight;
+    return reweighted;
+}
+
+// -----------------------------------------------------------------------------
+// Johnson's all-pairs shortest paths for sparse graphs with negative arcs: the
+// potentials of johnsonPotentials() make every arc weight non-negative, then
+// dijkstra() runs from every vertex on the reweighted graph and each distance is
+// translated back with d(s, v) = d'(s, v) - p[s] + p[v]. Graphs without negative arcs
+// skip the reweighting. The searches run on the pool, one tile row of sources per
+// task with a DijkstraWorkspace per worker, so every task fills whole tiles of the
+// matrix. O(nm log n) instead of the O(n^2 m) of a Bellman-Ford run per source.
+// Distances must stay below INF.
+// -----------------------------------------------------------------------------
+inline void johnsonAllPairs(const CsrGraph& graph, ThreadPool& pool, BlockedDistanceMatrix& matrix) {
+    int n = graph.vertexCount;
+    if (matrix.vertexCount() != n) {
+        throw runtime_error("Distance matrix does not match the graph!");
+    }
+    vector<int> potential(n + 1, 0);
+    CsrGraph reweighted;
+    const CsrGraph* searched = &graph;
+    if (graph.minWeight < 0) {
+        potential = johnsonPotentials(graph);
+        reweighted = reweightedCsrGraph(graph, potential);
+        searched = &reweighted;
+    }
+    vector<DijkstraWorkspace> workspaces;
+    vector<vector<int>> rows;
+    for (int i = 0; i < pool.size(); i++) {
+        workspaces.emplace_back(n);
+        rows.emplace_back(n + 1, INF);
+    }
+    pool.parallelFor(matrix.tileCount(), [&](int bi, int worker) {
+        DijkstraWorkspace& ws = workspaces[worker];
+        vector<int>& row = rows[worker];
+        int last = min(n, (bi + 1) * DISTANCE_TILE);
+        for (int s = bi * DISTANCE_TILE + 1; s <= last; s++) {
+            dijkstra(*searched, s, ws);
+            for (int v : ws.touched) {
+                row[v] = ws.dist[v] - potential[s] + potential[v];
+            }
+            matrix.setRow(s, row.data());
+            for (int v : ws.touched) {
+                row[v] = INF;
+            }
+        }
+    });
+}
+
+inline BlockedDistanceMatrix johnsonAllPairs(const CsrGraph& graph, ThreadPool& pool) {
+    BlockedDistanceMatrix matrix(graph.vertexCount);
+    johnsonAllPairs(graph, pool, matrix);
+    return matrix;
+}
+
+// c[i][j] = min(c[i][j], a[i][k] + b[k][j]) over one tile, with k as the outer loop so
+// that c may be a or b: the pivot tile and the pivot row and column of blocked
+// Floyd-Warshall. Sums with an INF operand stay INF.
+inline void minPlusTile(int* c, const int* a, const int* b) {
+    const int T = DISTANCE_TILE;
+    int bk[T];  // a local copy cannot alias c, so the scalar loop vectorizes too
+    for (int k = 0; k < T; k++) {
+        copy(b + k * T, b + (k + 1) * T, bk);
+        for (int i = 0; i < T; i++) {
+            int aik = a[i * T + k];
+            if (aik >= INF) {
+                continue;
+            }
+            int* ci = c + i * T;
+#ifdef __AVX2__
+            __m256i va = _mm256_set1_epi32(aik);
+            __m256i vinf = _mm256_set1_epi32(INF);
+            for (int j = 0; j < T; j += 8) {
+                __m256i vb = _mm256_loadu_si256(reinterpret_cast<const __m256i*>(bk + j));
+                __m256i sum = _mm256_blendv_epi8(_mm256_add_epi32(vb, va), vinf, _mm256_cmpeq_epi32(vb, vinf));
+                __m256i vc = _mm256_loadu_si256(reinterpret_cast<const __m256i*>(ci + j));
+                _mm256_storeu_si256(reinterpret_cast<__m256i*>(ci + j), _mm256_min_epi32(vc, sum));
+            }
+#else
+            for (int j = 0; j < T; j++) {
+                int sum = bk[j] >= INF ? INF : aik + bk[j];
+                ci[j] = min(ci[j], sum);
+            }
+#endif
+        }
+    }
+}
+
+// minPlusTile() for a c distinct from a and b: with i as the outer loop, a row of c
+// stays in registers (eight AVX2 vectors, or a local array) while every k is applied
+// to it.
+inline void minPlusTileDisjoint(int* c, const int* a, const int* b) {
+    const int T = DISTANCE_TILE;
+    for (int i = 0; i < T; i++) {
+        int* ci = c + i * T;
+        const int* ai = a + i * T;
+#ifdef __AVX2__
+        __m256i vinf = _mm256_set1_epi32(INF);
+        __m256i row[T / 8];
+        for (int j = 0; j < T / 8; j++) {
+            row[j] = _mm256_loadu_si256(reinterpret_cast<const __m256i*>(ci + 8 * j));
+        }
+        for (int k = 0; k < T; k++) {
+            if (ai[k] >= INF) {
+                continue;
+            }
+            __m256i va = _mm256_set1_epi32(ai[k]);
+            const int* bk = b + k * T;
+            for (int j = 0; j < T / 8; j++) {
+                __m256i vb = _mm256_loadu_si256(reinterpret_cast<const __m256i*>(bk + 8 * j));
+                __m256i sum = _mm256_blendv_epi8(_mm256_add_epi32(vb, va), vinf, _mm256_cmpeq_epi32(vb, vinf));
+                row[j] = _mm256_min_epi32(row[j], sum);
+            }
+        }
+        for (int j = 0; j < T / 8; j++) {
+            _mm256_storeu_si256(reinterpret_cast<__m256i*>(ci + 8 * j), row[j]);
+        }
+#else
+        int row[T];
+        copy(ci, ci + T, row);
+        for (int k = 0; k < T; k++) {
+            int aik = ai[k];
+            if (aik >= INF) {
+                continue;
+            }
+            const int* bk = b + k * T;
+            for (int j = 0; j < T; j++) {
+                int sum = bk[j] >= INF ? INF : aik + bk[j];
+                row[j] = min(row[j], sum);
+            }
+        }
+        copy(row, row + T, ci);
+#endif
+    }
+}
+
+// -----------------------------------------------------------------------------
+// Blocked Floyd-Warshall over a matrix that holds the arc weights (0 on the diagonal,
+// INF for missing arcs). For every pivot tile row kb it closes the pivot tile, then
+// the other tiles of its row and column against it, then every remaining tile from
+// its row and column tiles; the last two steps run on the pool, one tile per task.
+// O(n^3) with SIMD min-plus kernels, which beats Johnson on small dense graphs.
+// Throws if the graph has a negative cycle. Distances must stay below INF / 2.
+// -----------------------------------------------------------------------------
+inline void floydWarshall(BlockedDistanceMatrix& matrix, ThreadPool& pool) {
+    int tiles = matrix.tileCount();
+    for (int kb = 0; kb < tiles; kb++) {
+        int* pivot = matrix.tile(kb, kb);
+        minPlusTile(pivot, pivot, pivot);
+        pool.parallelFor(2 * tiles, [&](int task, int) {
+            int t = task / 2;
+            if (t == kb) {
+                return;
+            }
+            if (task % 2 == 0) {
+                int* c = matrix.tile(kb, t);
+                minPlusTile(c, pivot, c);
+            } else {
+                int* c = matrix.tile(t, kb);
+                minPlusTile(c, c, pivot);
+            }
+        });
+        pool.parallelFor(tiles * tiles, [&](int task, int) {
+            int bi = task / tiles, bj = task % tiles;
+            if (bi != kb && bj != kb) {
+                minPlusTileDisjoint(matrix.tile(bi, bj), matrix.tile(bi, kb), matrix.tile(kb, bj));
+            }
+        });
+    }
+    for (int v = 1; v <= matrix.vertexCount(); v++) {
+        if (matrix.at(v, v) < 0) {
+            throw runtime_error("Negative cycle!");
+        }
+    }
+}
+
+// Fills the matrix with the arc weights of the graph (the lightest of parallel arcs)
+// and runs floydWarshall() on it.
+inline void floydWarshallAllPairs(const CsrGraph& graph, ThreadPool& pool, BlockedDistanceMatrix& matrix) {
+    int n = graph.vertexCount;
+    if (matrix.vertexCount() != n) {
+        throw runtime_error("Distance matrix does not match the graph!");
+    }
+    vector<int> row(n + 1, INF);
+    for (int u = 1; u <= n; u++) {
+        row[u] = 0;
+        for (int a = graph.offsets[u]; a < graph.offsets[u + 1]; a++) {
+            int v = graph.targets[a];
+            row[v] = min(row[v], graph.weights[a]);
+        }
+        matrix.setRow(u, row.data());
+        for (int a = graph.offsets[u]; a < graph.offsets[u + 1]; a++) {
+            row[graph.targets[a]] = INF;
+        }
+        row[u] = INF;
+    }
+    floydWarshall(matrix, pool);
+}
+
+inline BlockedDistanceMatrix floydWarshallAllPairs(const CsrGraph& graph, ThreadPool& pool) {
+    BlockedDistanceMatrix matrix(graph.vertexCount);
+    floydWarshallAllPairs(graph, pool, matrix);
+    return matrix;
+}
+
+// Floyd-Warshall for small dense graphs (see FLOYD_WARSHALL_MAX_VERTICES and
+// FLOYD_WARSHALL_DENSITY), Johnson otherwise.
+inline void allPairsShortestPaths(const CsrGraph& graph, ThreadPool& pool, BlockedDistanceMatrix& matrix) {
+    long long n = graph.vertexCount;
+    if (n <= FLOYD_WARSHALL_MAX_VERTICES && static_cast<long long>(graph.arcCount()) * FLOYD_WARSHALL_DENSITY >= n * n) {
+        floydWarshallAllPairs(graph, pool, matrix);
+    } else {
+        johnsonAllPairs(graph, pool, matrix);
+    }
+}
+
+inline BlockedDistanceMatrix allPairsShortestPaths(const CsrGraph& graph, ThreadPool& pool) {
+    BlockedDistanceMatrix matrix(graph.vertexCount);
+    allPairsShortestPaths(graph, pool, matrix);
+    return matrix;
+}
+
+#endif // ALL_PAIRS_SHORTEST_PATHS_HPP
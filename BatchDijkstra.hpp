@@ -0,0 +1,81 @@
+#ifndef BATCH_DIJKSTRA_HPP
+#define BATCH_DIJKSTRA_HPP
+
+#include "CsrGraph.hpp"
+#include "DijkstraAlgorithm.hpp"
+#include "ThreadPool.hpp"
+#include <functional>
+#include <vector>
+using namespace std;
+
+// Row-major matrix of shortest distances: row i holds the result of dijkstra() from
+// the i-th source, indexed by vertex (1-indexed, column 0 is unused) just like the
+// vector returned by dijkstra().
+struct DistanceMatrix {
+    int rows;
+    int cols;
+    vector<int> data;
+
+    int* row(int i) {
+        return data.data() + static_cast<size_t>(i) * cols;
+    }
+
+    const int* row(int i) const {
+        return data.data() + static_cast<size_t>(i) * cols;
+    }
+
+    int at(int i, int v) const {
+        return row(i)[v];
+    }
+};
+
+// -----------------------------------------------------------------------------
+// Runs Dijkstra from many sources over one shared, read-only CsrGraph.
+// Sources are distributed over a work-stealing ThreadPool and every worker keeps its
+// own DijkstraWorkspace across sources and across calls, so after the first few
+// queries no per-source allocation happens except for the output itself.
+// -----------------------------------------------------------------------------
+class BatchDijkstra {
+  public:
+    BatchDijkstra(const CsrGraph& graph, ThreadPool& pool)
+        : graph(graph), pool(pool) {
+        for (int i = 0; i < pool.size(); i++) {
+            workspaces.emplace_back(graph.vertexCount);
+        }
+    }
+
+    // Computes the full distance matrix for the given sources.
+    DistanceMatrix run(const vector<int>& sources) {
+        DistanceMatrix matrix;
+        matrix.rows = static_cast<int>(sources.size());
+        matrix.cols = graph.vertexCount + 1;
+        matrix.data.assign(static_cast<size_t>(matrix.rows) * matrix.cols, INF);
+        pool.parallelFor(matrix.rows, [&](int i, int worker) {
+            DijkstraWorkspace& ws = workspaces[worker];
+            dijkstra(graph, sources[i], ws);
+            int* out = matrix.row(i);
+            for (int v : ws.touched)
+                out[v] = ws.dist[v];
+        });
+        return matrix;
+    }
+
+    // Streams the result of every source to callback(i, ws) instead of materializing a
+    // matrix. ws.dist and ws.touched describe the run from sources[i] and are only valid
+    // during the call. The callback is invoked concurrently from several workers.
+    void run(const vector<int>& sources,
+             const function<void(int, const DijkstraWorkspace&)>& callback) {
+        pool.parallelFor(static_cast<int>(sources.size()), [&](int i, int worker) {
+            DijkstraWorkspace& ws = workspaces[worker];
+            dijkstra(graph, sources[i], ws);
+            callback(i, ws);
+        });
+    }
+
+  private:
+    const CsrGraph& graph;
+    ThreadPool& pool;
+    vector<DijkstraWorkspace> workspaces;
+};
+
+#endif // BATCH_DIJKSTRA_HPP
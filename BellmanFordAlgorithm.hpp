@@ -2,30 +2,322 @@
 #define BELLMAN_FORD_HPP
 
 #include "GraphGenerator.hpp"
+#include "CsrGraph.hpp"
+#include "AlgorithmStats.hpp"
+#include "WeightTraits.hpp"
+#include <algorithm>
 #include <vector>
 #include <tuple>
+#ifdef __AVX2__
+#include <immintrin.h>
+#endif
 using namespace std;
 
-const int INF_1 = 1e9;
+const int INF_1 = WeightTraits<int>::infinity();
 
-inline vector<int> bellmanFord(const Graph &graph, int start) {
+// Bellman-Ford over a prebuilt CSR graph. Undirected edges are stored in both
+// directions in the CSR arrays, so a single sweep over all arcs relaxes both.
+// Stops as soon as a pass changes nothing. Distances are meaningless if a negative
+// cycle is reachable from start; use bellmanFordQueue() to detect that case.
+// Unreachable vertices get WeightTraits<W>::infinity() (INF_1 for int).
+// stats receives one "pass" phase per pass (see AlgorithmStats.hpp).
+template <class W, bool Enabled>
+inline vector<W> bellmanFord(const BasicCsrGraph<W> &graph, int start, AlgorithmStats<Enabled> &stats) {
+    const W inf = WeightTraits<W>::infinity();
     int n = graph.vertexCount;
-    vector<int> dist(n + 1, INF_1);
+    vector<W> dist(n + 1, inf);
     dist[start] = 0;
+    stats.beginPhase("bellmanFord");
 
     for (int i = 1; i < n; i++) {
-        for (const auto& edge : graph.edges) {
-            int u, v, w;
-            tie(u, v, w) = edge;
-            if (dist[u] < INF_1 && dist[v] > dist[u] + w) {
-                dist[v] = dist[u] + w;
+        bool changed = false;
+        stats.beginPhase("pass");
+        stats.count(StatCounter::Passes);
+        for (int u = 1; u <= n; u++) {
+            if (dist[u] >= inf)
+                continue;
+            stats.count(StatCounter::ArcScans, graph.offsets[u + 1] - graph.offsets[u]);
+            for (int a = graph.offsets[u]; a < graph.offsets[u + 1]; a++) {
+                int v = graph.targets[a];
+                W candidate = WeightTraits<W>::add(dist[u], graph.weights[a]);
+                if (dist[v] > candidate) {
+                    dist[v] = candidate;
+                    stats.count(StatCounter::Relaxations);
+                    changed = true;
+                }
             }
-            if (!graph.isDirected && dist[v] < INF_1 && dist[u] > dist[v] + w) {
-                dist[u] = dist[v] + w;
+        }
+        stats.endPhase();
+        if (!changed)
+            break;
+    }
+    stats.endPhase();
+    return dist;
+}
+
+template <class W>
+inline vector<W> bellmanFord(const BasicCsrGraph<W> &graph, int start) {
+    return bellmanFord(graph, start, nullStats());
+}
+
+template <class W>
+inline vector<W> bellmanFord(const BasicGraph<W> &graph, int start) {
+    return bellmanFord(buildCsrGraph(graph), start);
+}
+
+// Smallest of best and add(dist[sources[i]], weights[i]) over the count arcs given by
+// the parallel arrays sources and weights: the relaxation of every arc entering one
+// vertex. The portable version is below; with AVX2 the overloads after it gather
+// eight (int, float) or four (64-bit, double) distances at a time, and overload
+// resolution picks them at compile time. All versions compute the same value.
+template <class W>
+inline W minInArcDistance(const W *dist, const int *sources, const W *weights, int count, W best) {
+    for (int i = 0; i < count; i++) {
+        best = min(best, WeightTraits<W>::add(dist[sources[i]], weights[i]));
+    }
+    return best;
+}
+
+#ifdef __AVX2__
+inline int minInArcDistance(const int *dist, const int *sources, const int *weights, int count, int best) {
+    const __m256i inf = _mm256_set1_epi32(WeightTraits<int>::infinity());
+    const __m256i belowInf = _mm256_set1_epi32(WeightTraits<int>::infinity() - 1);
+    __m256i acc = _mm256_set1_epi32(best);
+    int i = 0;
+    for (; i + 8 <= count; i += 8) {
+        __m256i index = _mm256_loadu_si256(reinterpret_cast<const __m256i *>(sources + i));
+        __m256i d = _mm256_i32gather_epi32(dist, index, 4);
+        __m256i w = _mm256_loadu_si256(reinterpret_cast<const __m256i *>(weights + i));
+        __m256i sum = _mm256_add_epi32(d, w);
+        // Signed overflow iff the sum's sign differs from both operands; it saturates
+        // to INT_MAX or INT_MIN by the sign of w, then everything to infinity().
+        __m256i overflow = _mm256_srai_epi32(_mm256_and_si256(_mm256_xor_si256(d, sum), _mm256_xor_si256(w, sum)), 31);
+        __m256i saturated = _mm256_xor_si256(_mm256_srai_epi32(w, 31), _mm256_set1_epi32(numeric_limits<int>::max()));
+        sum = _mm256_blendv_epi8(sum, saturated, overflow);
+        sum = _mm256_blendv_epi8(_mm256_min_epi32(sum, inf), inf, _mm256_cmpgt_epi32(d, belowInf));
+        acc = _mm256_min_epi32(acc, sum);
+    }
+    alignas(32) int lanes[8];
+    _mm256_store_si256(reinterpret_cast<__m256i *>(lanes), acc);
+    for (int lane = 0; lane < 8; lane++) {
+        best = min(best, lanes[lane]);
+    }
+    return minInArcDistance<int>(dist, sources + i, weights + i, count - i, best);
+}
+
+// 64-bit integer version for long and long long, whichever int64_t is.
+template <class W>
+inline W minInArcDistance64(const W *dist, const int *sources, const W *weights, int count, W best) {
+    const __m256i inf = _mm256_set1_epi64x(WeightTraits<W>::infinity());
+    const __m256i lowest = _mm256_set1_epi64x(numeric_limits<W>::min());
+    const __m256i zero = _mm256_setzero_si256();
+    __m256i acc = _mm256_set1_epi64x(best);
+    int i = 0;
+    for (; i + 4 <= count; i += 4) {
+        __m128i index = _mm_loadu_si128(reinterpret_cast<const __m128i *>(sources + i));
+        __m256i d = _mm256_i32gather_epi64(reinterpret_cast<const long long *>(dist), index, 8);
+        __m256i w = _mm256_loadu_si256(reinterpret_cast<const __m256i *>(weights + i));
+        __m256i sum = _mm256_add_epi64(d, w);
+        __m256i overflow = _mm256_cmpgt_epi64(zero, _mm256_and_si256(_mm256_xor_si256(d, sum), _mm256_xor_si256(w, sum)));
+        __m256i saturated = _mm256_blendv_epi8(inf, lowest, _mm256_cmpgt_epi64(zero, w));
+        sum = _mm256_blendv_epi8(sum, saturated, overflow);
+        sum = _mm256_blendv_epi8(sum, inf, _mm256_cmpeq_epi64(d, inf));
+        acc = _mm256_blendv_epi8(acc, sum, _mm256_cmpgt_epi64(acc, sum));
+    }
+    alignas(32) long long lanes[4];
+    _mm256_store_si256(reinterpret_cast<__m256i *>(lanes), acc);
+    for (int lane = 0; lane < 4; lane++) {
+        best = min(best, static_cast<W>(lanes[lane]));
+    }
+    return minInArcDistance<W>(dist, sources + i, weights + i, count - i, best);
+}
+
+inline long minInArcDistance(const long *dist, const int *sources, const long *weights, int count, long best) {
+    return minInArcDistance64(dist, sources, weights, count, best);
+}
+
+inline long long minInArcDistance(const long long *dist, const int *sources, const long long *weights, int count,
+                                  long long best) {
+    return minInArcDistance64(dist, sources, weights, count, best);
+}
+
+inline float minInArcDistance(const float *dist, const int *sources, const float *weights, int count, float best) {
+    __m256 acc = _mm256_set1_ps(best);
+    int i = 0;
+    for (; i + 8 <= count; i += 8) {
+        __m256i index = _mm256_loadu_si256(reinterpret_cast<const __m256i *>(sources + i));
+        __m256 d = _mm256_i32gather_ps(dist, index, 4);
+        acc = _mm256_min_ps(acc, _mm256_add_ps(d, _mm256_loadu_ps(weights + i)));
+    }
+    alignas(32) float lanes[8];
+    _mm256_store_ps(lanes, acc);
+    for (int lane = 0; lane < 8; lane++) {
+        best = min(best, lanes[lane]);
+    }
+    return minInArcDistance<float>(dist, sources + i, weights + i, count - i, best);
+}
+
+inline double minInArcDistance(const double *dist, const int *sources, const double *weights, int count, double best) {
+    // The masked gather, as GCC warns about the undefined source of _mm256_i32gather_pd.
+    const __m256d all = _mm256_castsi256_pd(_mm256_set1_epi64x(-1));
+    __m256d acc = _mm256_set1_pd(best);
+    int i = 0;
+    for (; i + 4 <= count; i += 4) {
+        __m128i index = _mm_loadu_si128(reinterpret_cast<const __m128i *>(sources + i));
+        __m256d d = _mm256_mask_i32gather_pd(_mm256_setzero_pd(), dist, index, all, 8);
+        acc = _mm256_min_pd(acc, _mm256_add_pd(d, _mm256_loadu_pd(weights + i)));
+    }
+    alignas(32) double lanes[4];
+    _mm256_store_pd(lanes, acc);
+    for (int lane = 0; lane < 4; lane++) {
+        best = min(best, lanes[lane]);
+    }
+    return minInArcDistance<double>(dist, sources + i, weights + i, count - i, best);
+}
+#endif
+
+// Pull-based Bellman-Ford over the reverse graph (buildReverseCsrGraph(graph), or
+// the graph itself when undirected), whose arcs of v are the arcs entering v in the
+// original graph as two flat arrays of sources and weights. Every pass sets each
+// vertex to the smallest distance over its incoming arcs with minInArcDistance(),
+// which reads the arc arrays sequentially and gathers the source distances, with no
+// data-dependent branch per arc. Updates are visible within the pass, as in
+// bellmanFord(), and it returns the same distances. A pass reads every arc, reached
+// or not, so it pays off when most vertices are reached in the first passes.
+// stats receives one "pass" phase per pass.
+template <class W, bool Enabled>
+inline vector<W> bellmanFordPull(const BasicCsrGraph<W> &reverse, int start, AlgorithmStats<Enabled> &stats) {
+    int n = reverse.vertexCount;
+    vector<W> dist(n + 1, WeightTraits<W>::infinity());
+    dist[start] = 0;
+    stats.beginPhase("bellmanFordPull");
+
+    for (int i = 1; i < n; i++) {
+        bool changed = false;
+        stats.beginPhase("pass");
+        stats.count(StatCounter::Passes);
+        stats.count(StatCounter::ArcScans, reverse.arcCount());
+        for (int v = 1; v <= n; v++) {
+            int first = reverse.offsets[v];
+            W best = minInArcDistance(dist.data(), reverse.targets.data() + first, reverse.weights.data() + first,
+                                      reverse.offsets[v + 1] - first, dist[v]);
+            if (best < dist[v]) {
+                dist[v] = best;
+                stats.count(StatCounter::Relaxations);
+                changed = true;
             }
         }
+        stats.endPhase();
+        if (!changed)
+            break;
     }
+    stats.endPhase();
     return dist;
 }
 
+template <class W>
+inline vector<W> bellmanFordPull(const BasicCsrGraph<W> &reverse, int start) {
+    return bellmanFordPull(reverse, start, nullStats());
+}
+
+// Result of bellmanFordQueue(). When hasNegativeCycle is set, negativeCycle lists the
+// vertices of a negative cycle reachable from the start in traversal order and dist
+// must not be used. Otherwise parent[v] is the predecessor of v on a shortest path
+// (-1 for the start and for unreachable vertices).
+template <class W>
+struct BasicBellmanFordResult {
+    vector<W> dist;
+    vector<int> parent;
+    bool hasNegativeCycle;
+    vector<int> negativeCycle;
+};
+
+typedef BasicBellmanFordResult<int> BellmanFordResult;
+
+// Looks for a cycle in the shortest path tree given by parent. Every such cycle has
+// negative total weight. Returns its vertices in traversal order, or an empty vector.
+inline vector<int> findParentCycle(const vector<int> &parent) {
+    int n = static_cast<int>(parent.size()) - 1;
+    vector<int> walk(n + 1, 0);  // id of the walk that first visited the vertex
+    for (int v = 1; v <= n; v++) {
+        if (walk[v] != 0)
+            continue;
+        int u = v;
+        while (u != -1 && walk[u] == 0) {
+            walk[u] = v;
+            u = parent[u];
+        }
+        if (u != -1 && walk[u] == v) {
+            vector<int> cycle;
+            int x = u;
+            do {
+                cycle.push_back(x);
+                x = parent[x];
+            } while (x != u);
+            reverse(cycle.begin(), cycle.end());
+            return cycle;
+        }
+    }
+    return {};
+}
+
+// Queue-based Bellman-Ford (SPFA). Only vertices whose distance changed are kept in a
+// FIFO queue of active vertices, so the run ends as soon as nothing changes, which is
+// close to O(E) on graphs that converge quickly instead of the O(VE) of full passes.
+// Negative cycles are detected with amortized searches for a cycle in the parent
+// pointers, run once per n relaxations (Cherkassky and Goldberg's "amortized search").
+template <class W>
+inline BasicBellmanFordResult<W> bellmanFordQueue(const BasicCsrGraph<W> &graph, int start) {
+    int n = graph.vertexCount;
+    BasicBellmanFordResult<W> result;
+    result.dist.assign(n + 1, WeightTraits<W>::infinity());
+    result.parent.assign(n + 1, -1);
+    result.hasNegativeCycle = false;
+    vector<W> &dist = result.dist;
+    vector<int> &parent = result.parent;
+
+    vector<int> queue(n + 1);  // circular FIFO; a vertex is in it at most once
+    vector<bool> inQueue(n + 1, false);
+    int head = 0, size = 0;
+    dist[start] = 0;
+    queue[0] = start;
+    inQueue[start] = true;
+    size = 1;
+    long long relaxations = 0;
+
+    while (size > 0) {
+        int u = queue[head];
+        head = (head + 1) % (n + 1);
+        size--;
+        inQueue[u] = false;
+
+        for (int a = graph.offsets[u]; a < graph.offsets[u + 1]; a++) {
+            int v = graph.targets[a];
+            W candidate = WeightTraits<W>::add(dist[u], graph.weights[a]);
+            if (dist[v] > candidate) {
+                dist[v] = candidate;
+                parent[v] = u;
+                if (++relaxations % n == 0) {
+                    result.negativeCycle = findParentCycle(parent);
+                    if (!result.negativeCycle.empty()) {
+                        result.hasNegativeCycle = true;
+                        return result;
+                    }
+                }
+                if (!inQueue[v]) {
+                    queue[(head + size) % (n + 1)] = v;
+                    size++;
+                    inQueue[v] = true;
+                }
+            }
+        }
+    }
+    return result;
+}
+
+template <class W>
+inline BasicBellmanFordResult<W> bellmanFordQueue(const BasicGraph<W> &graph, int start) {
+    return bellmanFordQueue(buildCsrGraph(graph), start);
+}
+
 #endif // BELLMAN_FORD_HPP
@@ -0,0 +1,217 @@
+#ifndef BORUVKA_HPP
+#define BORUVKA_HPP
+
+#include "CsrGraph.hpp"
+#include "ThreadPool.hpp"
+#include <atomic>
+#include <numeric>
+#include <stdexcept>
+#include <vector>
+using namespace std;
+
+// Union-find whose find() and unite() may run concurrently on several threads.
+// A root is always linked below a root with a smaller index, so every parent
+// pointer goes to a smaller vertex and concurrent unions cannot form a cycle.
+// find() halves paths with compare-and-swap; losing such a race is harmless.
+class ConcurrentDisjointSet {
+  public:
+    explicit ConcurrentDisjointSet(int n) : parent(n + 1) {
+        for (int i = 0; i <= n; i++) {
+            parent[i].store(i, memory_order_relaxed);
+        }
+    }
+
+    int find(int x) {
+        while (true) {
+            int p = parent[x].load();
+            if (p == x) {
+                return x;
+            }
+            int grandparent = parent[p].load();
+            if (grandparent != p) {
+                parent[x].compare_exchange_weak(p, grandparent);
+            }
+            x = grandparent;
+        }
+    }
+
+    // Returns false when a and b were already in the same set.
+    bool unite(int a, int b) {
+        while (true) {
+            a = find(a);
+            b = find(b);
+            if (a == b) {
+                return false;
+            }
+            if (a < b) {
+                swap(a, b);
+            }
+            int expected = a;
+            if (parent[a].compare_exchange_strong(expected, b)) {
+                return true;
+            }
+        }
+    }
+
+  private:
+    vector<atomic<int>> parent;
+};
+
+// -----------------------------------------------------------------------------
+// Parallel Borůvka minimum spanning forest. Every round finds, in parallel, the
+// lightest edge leaving each component (an atomic minimum per component root),
+// contracts the components along those edges with a ConcurrentDisjointSet and drops
+// the edges that now lie inside a component. Each round at least halves the number
+// of components, so there are at most log2(n) rounds.
+// Edges are compared by lighterEdge(): each edge gets a 64-bit key of its weight and
+// its index in an edge list ordered by endpoints, so the minima are unique, the
+// chosen edges never form a cycle and the result is exactly that of kruskal() and
+// prim() (for a connected graph), independent of the thread count.
+// -----------------------------------------------------------------------------
+class Boruvka {
+  public:
+    Boruvka(const CsrGraph& graph, ThreadPool& pool) : n(graph.vertexCount), pool(pool) {
+        if (graph.isDirected) {
+            throw runtime_error("Boruvka only for undirected!");
+        }
+        // Every edge once, from its smaller endpoint, ordered by (u, v, w).
+        vector<int> offsets(n + 2, 0);
+        pool.parallelFor(n, [&](int i, int) {
+            int u = i + 1;
+            int count = 0;
+            for (int a = graph.offsets[u]; a < graph.offsets[u + 1]; a++) {
+                count += graph.targets[a] > u;
+            }
+            offsets[u + 1] = count;
+        }, 1024);
+        for (int u = 1; u <= n + 1; u++) {
+            offsets[u] += offsets[u - 1];
+        }
+        int m = offsets[n + 1];
+        sources.resize(m);
+        ends.resize(m);
+        pool.parallelFor(n, [&](int i, int) {
+            int u = i + 1;
+            int next = offsets[u];
+            for (int a = graph.offsets[u]; a < graph.offsets[u + 1]; a++) {
+                if (graph.targets[a] > u) {
+                    sources[next] = u;
+                    ends[next++] = make_pair(graph.targets[a], graph.weights[a]);
+                }
+            }
+            sort(ends.begin() + offsets[u], ends.begin() + next);
+        }, 1024);
+    }
+
+    pair<long long, vector<tuple<int, int, int>>> run() {
+        int m = static_cast<int>(sources.size());
+        ConcurrentDisjointSet ds(n);
+        vector<atomic<unsigned long long>> lightest(n + 1);
+        for (auto& key : lightest) {
+            key.store(NO_EDGE, memory_order_relaxed);
+        }
+        vector<char> inTree(m, 0);
+        vector<int> active(m), kept(m);
+        iota(active.begin(), active.end(), 0);
+
+        while (!active.empty()) {
+            int blocks = (static_cast<int>(active.size()) + BLOCK_SIZE - 1) / BLOCK_SIZE;
+            pool.parallelFor(blocks, [&](int b, int) {
+                int end = min(static_cast<int>(active.size()), (b + 1) * BLOCK_SIZE);
+                for (int i = b * BLOCK_SIZE; i < end; i++) {
+                    int e = active[i];
+                    int cu = ds.find(sources[e]);
+                    int cv = ds.find(ends[e].first);
+                    if (cu != cv) {
+                        unsigned long long k = key(e);
+                        atomicMin(lightest[cu], k);
+                        atomicMin(lightest[cv], k);
+                    }
+                }
+            });
+
+            pool.parallelFor(n, [&](int i, int) {
+                unsigned long long k = lightest[i + 1].load(memory_order_relaxed);
+                if (k == NO_EDGE) {
+                    return;
+                }
+                lightest[i + 1].store(NO_EDGE, memory_order_relaxed);
+                int e = static_cast<int>(k & 0xffffffffULL);
+                // Both components may pick the same edge; only one union succeeds.
+                if (ds.unite(sources[e], ends[e].first)) {
+                    inTree[e] = 1;
+                }
+            }, 1024);
+
+            // Drop edges inside a component, keeping the order of the others.
+            vector<int> counts(blocks);
+            pool.parallelFor(blocks, [&](int b, int) {
+                int begin = b * BLOCK_SIZE;
+                int end = min(static_cast<int>(active.size()), begin + BLOCK_SIZE);
+                int next = begin;
+                for (int i = begin; i < end; i++) {
+                    int e = active[i];
+                    if (ds.find(sources[e]) != ds.find(ends[e].first)) {
+                        kept[next++] = e;
+                    }
+                }
+                counts[b] = next - begin;
+            });
+            vector<int> offsets(blocks + 1, 0);
+            for (int b = 0; b < blocks; b++) {
+                offsets[b + 1] = offsets[b] + counts[b];
+            }
+            pool.parallelFor(blocks, [&](int b, int) {
+                copy(kept.begin() + b * BLOCK_SIZE, kept.begin() + b * BLOCK_SIZE + counts[b],
+                     active.begin() + offsets[b]);
+            });
+            active.resize(offsets[blocks]);
+        }
+
+        long long totalWeight = 0;
+        vector<tuple<int, int, int>> tree;
+        for (int e = 0; e < m; e++) {
+            if (inTree[e]) {
+                tree.push_back(make_tuple(sources[e], ends[e].first, ends[e].second));
+                totalWeight += ends[e].second;
+            }
+        }
+        sort(tree.begin(), tree.end(), lighterEdge);
+        return {totalWeight, tree};
+    }
+
+  private:
+    static const int BLOCK_SIZE = 4096;
+    static const unsigned long long NO_EDGE = ~0ULL;
+
+    int n;
+    ThreadPool& pool;
+    vector<int> sources;            // smaller endpoint of each edge
+    vector<pair<int, int>> ends;    // (larger endpoint, weight) of each edge
+
+    // Orders edges by weight, then by index, which matches lighterEdge().
+    unsigned long long key(int e) const {
+        unsigned weight = static_cast<unsigned>(ends[e].second) ^ 0x80000000u;
+        return (static_cast<unsigned long long>(weight) << 32) | static_cast<unsigned>(e);
+    }
+
+    static void atomicMin(atomic<unsigned long long>& target, unsigned long long value) {
+        unsigned long long current = target.load(memory_order_relaxed);
+        while (value < current && !target.compare_exchange_weak(current, value, memory_order_relaxed)) {
+        }
+    }
+};
+
+inline pair<long long, vector<tuple<int, int, int>>> boruvka(const CsrGraph& graph, ThreadPool& pool) {
+    Boruvka solver(graph, pool);
+    return solver.run();
+}
+
+inline pair<long long, vector<tuple<int, int, int>>> boruvka(const Graph& graph, ThreadPool& pool) {
+    if (graph.isDirected) {
+        throw runtime_error("Boruvka only for undirected!");
+    }
+    return boruvka(buildCsrGraph(graph), pool);
+}
+
+#endif // BORUVKA_HPP
@@ -0,0 +1,511 @@
+#ifndef CONTRACTION_HIERARCHY_HPP
+#define CONTRACTION_HIERARCHY_HPP
+
+#include "CsrGraph.hpp"
+#include "DijkstraAlgorithm.hpp"
+#include "PriorityQueues.hpp"
+#include "ShortestPathQuery.hpp"
+#include <algorithm>
+#include <climits>
+#include <cstdint>
+#include <fstream>
+#include <stdexcept>
+#include <string>
+#include <vector>
+using namespace std;
+
+// Header of the contraction hierarchy file format.
+const char CH_FILE_MAGIC[] = "GRCH";
+const int32_t CH_FILE_VERSION = 1;
+
+// -----------------------------------------------------------------------------
+// Contraction hierarchies (Geisberger et al.) for repeated s-t queries on a static
+// graph with non-negative weights.
+//
+// Preprocessing contracts the vertices one by one in order of their edge difference
+// (shortcuts added minus arcs removed, plus the number of already contracted
+// neighbors), re-evaluated lazily when a vertex reaches the top of the queue. For each
+// pair of arcs u -> v -> w around the contracted vertex v, a bounded witness search
+// from u looks for a path to w that avoids v and is not longer; if none is found, a
+// shortcut u -> w is inserted. The rank of a vertex is its position in this order.
+//
+// A query runs Dijkstra from s over the upward arcs (towards higher rank) and from t
+// over the reversed downward arcs, and takes the best vertex reached by both sides.
+// Each arc remembers the vertex it bypasses, so paths are unpacked recursively.
+// -----------------------------------------------------------------------------
+class ContractionHierarchy {
+  public:
+    explicit ContractionHierarchy(const CsrGraph& graph) : n(graph.vertexCount) {
+        if (graph.minWeight < 0) {
+            throw runtime_error("Contraction hierarchies only for non-negative weights!");
+        }
+        Contractor contractor(graph);
+        contractor.run(rank, up, down);
+        allocateSearchSpaces();
+    }
+
+    int vertexCount() const {
+        return n;
+    }
+
+    int shortcutCount() const {
+        int shortcuts = 0;
+        for (int m : up.middles)
+            shortcuts += m != -1;
+        for (int m : down.middles)
+            shortcuts += m != -1;
+        return shortcuts;
+    }
+
+    // Shortest distance from source to target, INF if unreachable.
+    int distance(int source, int target) {
+        return search(source, target).first;
+    }
+
+    // Shortest distance and path (in original arcs) from source to target.
+    PathResult query(int source, int target) {
+        pair<int, int> found = search(source, target);
+        PathResult result;
+        result.distance = found.first;
+        if (found.first == INF)
+            return result;
+        int meeting = found.second;
+
+        vector<int> upward;  // meeting, ..., source in the forward search tree
+        for (int v = meeting; v != -1; v = forwardSpace.parent[v])
+            upward.push_back(v);
+        result.path.push_back(source);
+        for (int i = static_cast<int>(upward.size()) - 1; i > 0; i--)
+            unpack(upward[i], upward[i - 1], forwardSpace.dist[upward[i - 1]] - forwardSpace.dist[upward[i]], result.path);
+        for (int v = meeting; backwardSpace.parent[v] != -1; v = backwardSpace.parent[v]) {
+            int next = backwardSpace.parent[v];
+            unpack(v, next, backwardSpace.dist[v] - backwardSpace.dist[next], result.path);
+        }
+        return result;
+    }
+
+    // Writes the hierarchy in a versioned binary format.
+    void save(const string& path) const {
+        ofstream out(path, ios::binary);
+        if (!out) {
+            throw runtime_error("Cannot open " + path + " for writing!");
+        }
+        out.write(CH_FILE_MAGIC, 4);
+        writeValue(out, CH_FILE_VERSION);
+        writeValue(out, n);
+        writeArray(out, rank);
+        up.write(out);
+        down.write(out);
+        if (!out) {
+            throw runtime_error("Failed to write " + path + "!");
+        }
+    }
+
+    static ContractionHierarchy load(const string& path) {
+        ifstream in(path, ios::binary);
+        char magic[4];
+        if (!in || !in.read(magic, 4) || !equal(magic, magic + 4, CH_FILE_MAGIC)) {
+            throw runtime_error(path + " is not a contraction hierarchy file!");
+        }
+        in.seekg(0, ios::end);
+        streamoff fileSize = in.tellg();
+        in.seekg(4);
+        ContractionHierarchy ch;
+        if (readValue<int32_t>(in) != CH_FILE_VERSION) {
+            throw runtime_error("Unsupported contraction hierarchy version in " + path + "!");
+        }
+        ch.n = readValue<int32_t>(in);
+        if (!in || ch.n < 0 || ch.n > INT_MAX - 2) {
+            throw runtime_error("Corrupted contraction hierarchy file!");
+        }
+        readArray(in, fileSize, ch.rank);
+        ch.up.read(in, fileSize);
+        ch.down.read(in, fileSize);
+        if (!in) {
+            throw runtime_error("Truncated contraction hierarchy file " + path + "!");
+        }
+        if (ch.rank.size() != static_cast<size_t>(ch.n) + 1 || !ch.up.isValid(ch.n, ch.rank) ||
+            !ch.down.isValid(ch.n, ch.rank)) {
+            throw runtime_error("Corrupted contraction hierarchy file!");
+        }
+        ch.allocateSearchSpaces();
+        return ch;
+    }
+
+  private:
+    // Arcs attached to their lower-ranked endpoint, in CSR form. In `up` the arcs of u
+    // lead to higher-ranked targets; in `down` they are reversed downward arcs, i.e.
+    // v is listed under w for an original or shortcut arc v -> w with rank v > rank w.
+    // middles[a] is the bypassed vertex of a shortcut, -1 for an original arc.
+    struct SearchGraph {
+        vector<int> offsets;
+        vector<int> targets;
+        vector<int> weights;
+        vector<int> middles;
+
+        void write(ofstream& out) const {
+            writeArray(out, offsets);
+            writeArray(out, targets);
+            writeArray(out, weights);
+            writeArray(out, middles);
+        }
+
+        void read(ifstream& in, streamoff fileSize) {
+            readArray(in, fileSize, offsets);
+            readArray(in, fileSize, targets);
+            readArray(in, fileSize, weights);
+            readArray(in, fileSize, middles);
+        }
+
+        // Whether the arrays form a CSR graph on vertices 1..n that the queries and
+        // unpack() can walk without leaving them: every arc leads to a higher rank and
+        // bypasses a lower one, so unpacking a shortcut terminates.
+        bool isValid(int n, const vector<int>& rank) const {
+            if (offsets.size() != static_cast<size_t>(n) + 2 || offsets[0] != 0 || targets.size() != weights.size() ||
+                targets.size() != middles.size() || static_cast<size_t>(offsets.back()) != targets.size()) {
+                return false;
+            }
+            for (int v = 0; v <= n; v++) {
+                if (offsets[v] > offsets[v + 1])
+                    return false;
+            }
+            for (int u = 1; u <= n; u++) {
+                for (int a = offsets[u]; a < offsets[u + 1]; a++) {
+                    int v = targets[a], m = middles[a];
+                    if (v < 1 || v > n || rank[v] <= rank[u] || weights[a] < 0)
+                        return false;
+                    if (m != -1 && (m < 1 || m > n || rank[m] >= rank[u]))
+                        return false;
+                }
+            }
+            return true;
+        }
+
+        // The arc u -> target with the given weight.
+        int findArc(int u, int target, int weight) const {
+            for (int a = offsets[u]; a < offsets[u + 1]; a++) {
+                if (targets[a] == target && weights[a] == weight)
+                    return a;
+            }
+            throw runtime_error("Inconsistent contraction hierarchy!");
+        }
+    };
+
+    // Arc of the graph that is being contracted.
+    struct ContractionArc {
+        int target;
+        int weight;
+        int middle;
+    };
+
+    // Performs the contraction. in[v] lists the arcs u -> v as {u, weight, middle}.
+    class Contractor {
+      public:
+        explicit Contractor(const CsrGraph& graph)
+            : n(graph.vertexCount), out(n + 1), in(n + 1), contracted(n + 1, false),
+              contractedNeighbors(n + 1, 0), witnessDist(n + 1, INF),
+              targetStamp(n + 1, 0) {
+            for (int u = 1; u <= n; u++) {
+                for (int a = graph.offsets[u]; a < graph.offsets[u + 1]; a++) {
+                    if (graph.targets[a] != u)
+                        addArc(u, graph.targets[a], graph.weights[a], -1);
+                }
+            }
+        }
+
+        void run(vector<int>& rank, SearchGraph& up, SearchGraph& down) {
+            vector<vector<ContractionArc>> upArcs(n + 1), downArcs(n + 1);
+            rank.assign(n + 1, 0);
+            BinaryHeapQueue<int> order;
+            for (int v = 1; v <= n; v++)
+                order.push(priority(v), v);
+
+            int nextRank = 1;
+            while (!order.empty()) {
+                pair<int, int> top = order.pop();
+                int v = top.second;
+                if (contracted[v])
+                    continue;
+                // Lazy update: contract v only if it is still the best candidate.
+                int current = priority(v);
+                if (!order.empty()) {
+                    pair<int, int> next = order.pop();
+                    order.push(next.first, next.second);
+                    if (current > next.first) {
+                        order.push(current, v);
+                        continue;
+                    }
+                }
+                contract(v);
+                rank[v] = nextRank++;
+                upArcs[v] = move(out[v]);
+                downArcs[v] = move(in[v]);
+            }
+            pack(upArcs, up);
+            pack(downArcs, down);
+        }
+
+      private:
+        // Settled-vertex budgets of the witness searches when estimating the priority
+        // and when actually contracting; an unfinished search only costs a shortcut.
+        static const int SIMULATION_SETTLE_LIMIT = 50;
+        static const int CONTRACTION_SETTLE_LIMIT = 500;
+
+        int n;
+        vector<vector<ContractionArc>> out;
+        vector<vector<ContractionArc>> in;
+        vector<bool> contracted;
+        vector<int> contractedNeighbors;
+        vector<int> witnessDist;
+        vector<int> witnessTouched;
+        vector<int> targetStamp;  // targetStamp[w] == stamp while w is a pending witness target
+        int stamp = 0;
+        BinaryHeapQueue<int> witnessQueue;
+
+        // Adds u -> v or lowers the weight of an existing parallel arc.
+        void addArc(int u, int v, int weight, int middle) {
+            for (auto& arc : out[u]) {
+                if (arc.target == v) {
+                    if (weight < arc.weight) {
+                        arc.weight = weight;
+                        arc.middle = middle;
+                        for (auto& back : in[v]) {
+                            if (back.target == u) {
+                                back.weight = weight;
+                                back.middle = middle;
+                            }
+                        }
+                    }
+                    return;
+                }
+            }
+            out[u].push_back({v, weight, middle});
+            in[v].push_back({u, weight, middle});
+        }
+
+        // Dijkstra from source in the remaining graph without `excluded`, stopped once
+        // the distance exceeds limit, all `targets` pending witness targets are settled,
+        // or settleLimit vertices are settled.
+        void witnessSearch(int source, int excluded, int limit, int targets, int settleLimit) {
+            for (int v : witnessTouched)
+                witnessDist[v] = INF;
+            witnessTouched.clear();
+            witnessQueue.clear();
+            witnessDist[source] = 0;
+            witnessTouched.push_back(source);
+            witnessQueue.push(0, source);
+            int settled = 0;
+            while (!witnessQueue.empty() && settled < settleLimit && targets > 0) {
+                pair<int, int> top = witnessQueue.pop();
+                int u = top.second;
+                if (top.first != witnessDist[u])
+                    continue;
+                if (top.first > limit)
+                    break;
+                settled++;
+                if (targetStamp[u] == stamp) {
+                    targetStamp[u] = 0;
+                    targets--;
+                }
+                for (const auto& arc : out[u]) {
+                    if (arc.target == excluded)
+                        continue;
+                    int d = WeightTraits<int>::add(top.first, arc.weight);
+                    if (d < witnessDist[arc.target]) {
+                        if (witnessDist[arc.target] == INF)
+                            witnessTouched.push_back(arc.target);
+                        witnessDist[arc.target] = d;
+                        witnessQueue.push(d, arc.target);
+                    }
+                }
+            }
+        }
+
+        // Counts (or, with apply, inserts) the shortcuts needed to contract v.
+        int shortcuts(int v, bool apply) {
+            int count = 0;
+            vector<ContractionArc> incoming = in[v];
+            vector<ContractionArc> outgoing = out[v];
+            for (const auto& from : incoming) {
+                if (outgoing.empty())
+                    break;
+                int limit = 0;
+                int targets = 0;
+                stamp++;
+                for (const auto& to : outgoing) {
+                    if (to.target != from.target) {
+                        limit = max(limit, WeightTraits<int>::add(from.weight, to.weight));
+                        targetStamp[to.target] = stamp;
+                        targets++;
+                    }
+                }
+                witnessSearch(from.target, v, limit, targets,
+                              apply ? CONTRACTION_SETTLE_LIMIT : SIMULATION_SETTLE_LIMIT);
+                for (const auto& to : outgoing) {
+                    int through = WeightTraits<int>::add(from.weight, to.weight);
+                    if (to.target == from.target || witnessDist[to.target] <= through)
+                        continue;
+                    count++;
+                    if (apply)
+                        addArc(from.target, to.target, through, v);
+                }
+            }
+            return count;
+        }
+
+        int priority(int v) {
+            int removed = static_cast<int>(in[v].size() + out[v].size());
+            return shortcuts(v, false) - removed + contractedNeighbors[v];
+        }
+
+        void contract(int v) {
+            shortcuts(v, true);
+            contracted[v] = true;
+            for (const auto& arc : out[v]) {
+                auto& list = in[arc.target];
+                list.erase(remove_if(list.begin(), list.end(),
+                                     [v](const ContractionArc& a) { return a.target == v; }),
+                           list.end());
+                contractedNeighbors[arc.target]++;
+            }
+            for (const auto& arc : in[v]) {
+                auto& list = out[arc.target];
+                list.erase(remove_if(list.begin(), list.end(),
+                                     [v](const ContractionArc& a) { return a.target == v; }),
+                           list.end());
+                contractedNeighbors[arc.target]++;
+            }
+        }
+
+        void pack(const vector<vector<ContractionArc>>& arcs, SearchGraph& graph) {
+            graph.offsets.assign(n + 2, 0);
+            for (int v = 1; v <= n; v++)
+                graph.offsets[v + 1] = graph.offsets[v] + static_cast<int>(arcs[v].size());
+            for (int v = 1; v <= n; v++) {
+                for (const auto& arc : arcs[v]) {
+                    graph.targets.push_back(arc.target);
+                    graph.weights.push_back(arc.weight);
+                    graph.middles.push_back(arc.middle);
+                }
+            }
+        }
+    };
+
+    int n;
+    vector<int> rank;
+    SearchGraph up;
+    SearchGraph down;
+    SearchSpace forwardSpace;
+    SearchSpace backwardSpace;
+
+    ContractionHierarchy() : n(0) {}
+
+    void allocateSearchSpaces() {
+        forwardSpace = SearchSpace(n);
+        backwardSpace = SearchSpace(n);
+    }
+
+    // Returns (distance, meeting vertex) of the upward/downward search.
+    pair<int, int> search(int source, int target) {
+        forwardSpace.reset();
+        backwardSpace.reset();
+        forwardSpace.radix.clear();
+        backwardSpace.radix.clear();
+        forwardSpace.reach(source, 0, -1);
+        backwardSpace.reach(target, 0, -1);
+        forwardSpace.radix.push(0, source);
+        backwardSpace.radix.push(0, target);
+        int best = INF;
+        int meeting = -1;
+
+        bool forwardTurn = true;
+        while (!forwardSpace.radix.empty() || !backwardSpace.radix.empty()) {
+            SearchSpace& space = forwardTurn ? forwardSpace : backwardSpace;
+            SearchSpace& other = forwardTurn ? backwardSpace : forwardSpace;
+            const SearchGraph& graph = forwardTurn ? up : down;
+            forwardTurn = !forwardTurn;
+            if (space.radix.empty())
+                continue;
+
+            pair<int, int> top = space.radix.pop();
+            int u = top.second;
+            if (top.first >= best) {
+                space.radix.clear();  // nothing better can come from this side
+                continue;
+            }
+            if (top.first != space.dist[u])
+                continue;
+            if (other.dist[u] < INF && WeightTraits<int>::add(top.first, other.dist[u]) < best) {
+                best = WeightTraits<int>::add(top.first, other.dist[u]);
+                meeting = u;
+            }
+            for (int a = graph.offsets[u]; a < graph.offsets[u + 1]; a++) {
+                int v = graph.targets[a];
+                int d = WeightTraits<int>::add(top.first, graph.weights[a]);
+                if (d < space.dist[v]) {
+                    space.reach(v, d, u);
+                    space.radix.push(d, v);
+                }
+            }
+        }
+        return {best, meeting};
+    }
+
+    // Appends the original path of the arc from -> to (after `from`) to path.
+    void unpack(int from, int to, int weight, vector<int>& path) const {
+        // An arc from -> to is stored under its lower-ranked endpoint.
+        int middle = rank[from] < rank[to]
+            ? up.middles[up.findArc(from, to, weight)]
+            : down.middles[down.findArc(to, from, weight)];
+        if (middle == -1) {
+            path.push_back(to);
+            return;
+        }
+        // Both halves of a shortcut are stored under the bypassed (lowest) vertex.
+        int first = down.weights[lightestArc(down, middle, from)];
+        unpack(from, middle, first, path);
+        unpack(middle, to, weight - first, path);
+    }
+
+    static int lightestArc(const SearchGraph& graph, int u, int target) {
+        int best = -1;
+        for (int a = graph.offsets[u]; a < graph.offsets[u + 1]; a++) {
+            if (graph.targets[a] == target && (best == -1 || graph.weights[a] < graph.weights[best]))
+                best = a;
+        }
+        if (best == -1) {
+            throw runtime_error("Inconsistent contraction hierarchy!");
+        }
+        return best;
+    }
+
+    template <class T>
+    static void writeValue(ofstream& out, const T& value) {
+        out.write(reinterpret_cast<const char*>(&value), sizeof(T));
+    }
+
+    template <class T>
+    static T readValue(ifstream& in) {
+        T value = T();
+        in.read(reinterpret_cast<char*>(&value), sizeof(T));
+        return value;
+    }
+
+    static void writeArray(ofstream& out, const vector<int>& values) {
+        writeValue(out, static_cast<int64_t>(values.size()));
+        out.write(reinterpret_cast<const char*>(values.data()), values.size() * sizeof(int));
+    }
+
+    // Reads a length-prefixed array, rejecting lengths the rest of the file cannot
+    // hold before allocating for them.
+    static void readArray(ifstream& in, streamoff fileSize, vector<int>& values) {
+        int64_t size = readValue<int64_t>(in);
+        if (!in || size < 0 || size > (fileSize - in.tellg()) / static_cast<int64_t>(sizeof(int))) {
+            throw runtime_error("Corrupted contraction hierarchy file!");
+        }
+        values.resize(size);
+        in.read(reinterpret_cast<char*>(values.data()), size * sizeof(int));
+    }
+};
+
+#endif // CONTRACTION_HIERARCHY_HPP
@@ -0,0 +1,271 @@
+#ifndef CSR_GRAPH_HPP
+#define CSR_GRAPH_HPP
+
+#include "GraphGenerator.hpp"
+#include <algorithm>
+#include <memory>
+#include <vector>
+#include <tuple>
+using namespace std;
+
+// Array of a CsrGraph. It behaves like the vector it used to be, but can also view
+// memory owned elsewhere (a graph file mapped by mapCsrGraph()), so a mapped graph
+// is used without copying it. Copies always own their elements, and any call that
+// changes the size first copies a viewed array into owned storage.
+template <class T>
+class CsrArray {
+  public:
+    CsrArray() : data_(nullptr), size_(0) {}
+
+    CsrArray(const CsrArray& other) : owned_(other.begin(), other.end()) {
+        sync();
+    }
+
+    CsrArray(CsrArray&& other) noexcept
+        : owned_(move(other.owned_)), data_(other.data_), size_(other.size_) {
+        other.data_ = nullptr;
+        other.size_ = 0;
+    }
+
+    CsrArray& operator=(const CsrArray& other) {
+        if (this != &other) {
+            owned_.assign(other.begin(), other.end());
+            sync();
+        }
+        return *this;
+    }
+
+    CsrArray& operator=(CsrArray&& other) noexcept {
+        owned_ = move(other.owned_);
+        data_ = other.data_;
+        size_ = other.size_;
+        other.data_ = nullptr;
+        other.size_ = 0;
+        return *this;
+    }
+
+    // An array viewing size elements at data, which must outlive it.
+    static CsrArray view(T* data, size_t size) {
+        CsrArray array;
+        array.data_ = data;
+        array.size_ = size;
+        return array;
+    }
+
+    bool isView() const {
+        return data_ != owned_.data();
+    }
+
+    size_t size() const { return size_; }
+    bool empty() const { return size_ == 0; }
+    T* data() { return data_; }
+    const T* data() const { return data_; }
+    T* begin() { return data_; }
+    T* end() { return data_ + size_; }
+    const T* begin() const { return data_; }
+    const T* end() const { return data_ + size_; }
+    T& operator[](size_t i) { return data_[i]; }
+    const T& operator[](size_t i) const { return data_[i]; }
+    T& back() { return data_[size_ - 1]; }
+    const T& back() const { return data_[size_ - 1]; }
+
+    void resize(size_t size, const T& value = T()) {
+        own();
+        owned_.resize(size, value);
+        sync();
+    }
+
+    void assign(size_t size, const T& value) {
+        owned_.assign(size, value);
+        sync();
+    }
+
+    template <class Iterator>
+    void assign(Iterator first, Iterator last) {
+        vector<T> values(first, last);
+        owned_.swap(values);
+        sync();
+    }
+
+    void push_back(const T& value) {
+        own();
+        owned_.push_back(value);
+        sync();
+    }
+
+    void reserve(size_t size) {
+        own();
+        owned_.reserve(size);
+        sync();
+    }
+
+    void clear() {
+        owned_.clear();
+        sync();
+    }
+
+  private:
+    vector<T> owned_;
+    T* data_;
+    size_t size_;
+
+    void own() {
+        if (isView()) {
+            owned_.assign(data_, data_ + size_);
+        }
+    }
+
+    void sync() {
+        data_ = owned_.data();
+        size_ = owned_.size();
+    }
+};
+
+// -----------------------------------------------------------------------------
+// Compressed sparse row (CSR) representation of a Graph.
+// The arcs leaving vertex u occupy positions [offsets[u], offsets[u + 1]) of the
+// targets and weights arrays. Vertices are 1-indexed like in Graph, so offsets
+// has vertexCount + 2 entries. An undirected edge is stored once in each direction.
+//
+// Build it once with buildCsrGraph() and pass it to every algorithm that is run
+// repeatedly on the same graph, instead of letting each call rebuild its own
+// adjacency list from Graph::edges.
+//
+// W is the weight type (see WeightTraits.hpp). CsrGraph, with int weights, is the
+// one every algorithm accepts; the shortest path algorithms also take the others.
+// -----------------------------------------------------------------------------
+template <class W>
+struct BasicCsrGraph {
+    int vertexCount;
+    bool isDirected;
+    CsrArray<int> offsets;
+    CsrArray<int> targets;
+    CsrArray<W> weights;
+    W minWeight;  // smallest and largest arc weight (0 when there are no arcs)
+    W maxWeight;
+    shared_ptr<void> storage;  // keeps the memory of viewed arrays alive
+
+    int arcCount() const {
+        return static_cast<int>(targets.size());
+    }
+
+    int degree(int u) const {
+        return offsets[u + 1] - offsets[u];
+    }
+};
+
+typedef BasicCsrGraph<int> CsrGraph;
+
+// Builds the CSR representation with a counting pass followed by a placement pass,
+// so every array is allocated exactly once. Arcs of each vertex keep the order of
+// graph.edges.
+template <class W>
+inline BasicCsrGraph<W> buildCsrGraph(const BasicGraph<W>& graph) {
+    int n = graph.vertexCount;
+    BasicCsrGraph<W> csr;
+    csr.vertexCount = n;
+    csr.isDirected = graph.isDirected;
+    csr.offsets.assign(n + 2, 0);
+
+    for (const auto& edge : graph.edges) {
+        csr.offsets[get<0>(edge) + 1]++;
+        if (!graph.isDirected) {
+            csr.offsets[get<1>(edge) + 1]++;
+        }
+    }
+    for (int u = 1; u <= n + 1; u++) {
+        csr.offsets[u] += csr.offsets[u - 1];
+    }
+
+    csr.targets.resize(csr.offsets[n + 1]);
+    csr.weights.resize(csr.offsets[n + 1]);
+    csr.minWeight = graph.edges.empty() ? W(0) : get<2>(graph.edges[0]);
+    csr.maxWeight = csr.minWeight;
+    vector<int> next(csr.offsets.begin(), csr.offsets.end() - 1);
+    for (const auto& edge : graph.edges) {
+        int u = get<0>(edge), v = get<1>(edge);
+        W w = get<2>(edge);
+        csr.minWeight = min(csr.minWeight, w);
+        csr.maxWeight = max(csr.maxWeight, w);
+        csr.targets[next[u]] = v;
+        csr.weights[next[u]++] = w;
+        if (!graph.isDirected) {
+            csr.targets[next[v]] = u;
+            csr.weights[next[v]++] = w;
+        }
+    }
+    return csr;
+}
+
+// Builds the reverse graph, in which the arcs leaving u are the arcs entering u in
+// graph. Backward searches (e.g. bidirectional Dijkstra) run on it. For undirected
+// graphs this is a copy.
+template <class W>
+inline BasicCsrGraph<W> buildReverseCsrGraph(const BasicCsrGraph<W>& graph) {
+    if (!graph.isDirected) {
+        return graph;
+    }
+    int n = graph.vertexCount;
+    BasicCsrGraph<W> reverse;
+    reverse.vertexCount = n;
+    reverse.isDirected = true;
+    reverse.minWeight = graph.minWeight;
+    reverse.maxWeight = graph.maxWeight;
+    reverse.offsets.assign(n + 2, 0);
+    for (int a = 0; a < graph.arcCount(); a++) {
+        reverse.offsets[graph.targets[a] + 1]++;
+    }
+    for (int u = 1; u <= n + 1; u++) {
+        reverse.offsets[u] += reverse.offsets[u - 1];
+    }
+
+    reverse.targets.resize(graph.arcCount());
+    reverse.weights.resize(graph.arcCount());
+    vector<int> next(reverse.offsets.begin(), reverse.offsets.end() - 1);
+    for (int u = 1; u <= n; u++) {
+        for (int a = graph.offsets[u]; a < graph.offsets[u + 1]; a++) {
+            int slot = next[graph.targets[a]]++;
+            reverse.targets[slot] = u;
+            reverse.weights[slot] = graph.weights[a];
+        }
+    }
+    return reverse;
+}
+
+// The graph with its weights converted to To, e.g. to run an int graph with int64_t
+// or double distances.
+template <class To, class From>
+inline BasicCsrGraph<To> convertWeights(const BasicCsrGraph<From>& graph) {
+    BasicCsrGraph<To> converted;
+    converted.vertexCount = graph.vertexCount;
+    converted.isDirected = graph.isDirected;
+    converted.offsets.assign(graph.offsets.begin(), graph.offsets.end());
+    converted.targets.assign(graph.targets.begin(), graph.targets.end());
+    converted.weights.resize(graph.arcCount());
+    for (int a = 0; a < graph.arcCount(); a++) {
+        converted.weights[a] = static_cast<To>(graph.weights[a]);
+    }
+    converted.minWeight = static_cast<To>(graph.minWeight);
+    converted.maxWeight = static_cast<To>(graph.maxWeight);
+    return converted;
+}
+
+// Returns the undirected edge {u, v} with its smaller endpoint first.
+inline tuple<int, int, int> orientedEdge(int u, int v, int w) {
+    return u <= v ? make_tuple(u, v, w) : make_tuple(v, u, w);
+}
+
+// Total order on oriented edges: by weight, then by endpoints. Breaking weight ties
+// this way makes the minimum spanning forest unique, so kruskal(), prim() and
+// boruvka() choose exactly the same edges.
+inline bool lighterEdge(const tuple<int, int, int>& a, const tuple<int, int, int>& b) {
+    if (get<2>(a) != get<2>(b)) {
+        return get<2>(a) < get<2>(b);
+    }
+    if (get<0>(a) != get<0>(b)) {
+        return get<0>(a) < get<0>(b);
+    }
+    return get<1>(a) < get<1>(b);
+}
+
+#endif // CSR_GRAPH_HPP
@@ -0,0 +1,167 @@
+#ifndef DELTA_STEPPING_HPP
+#define DELTA_STEPPING_HPP
+
+#include "CsrGraph.hpp"
+#include "DijkstraAlgorithm.hpp"
+#include "ThreadPool.hpp"
+#include <atomic>
+#include <stdexcept>
+#include <vector>
+using namespace std;
+
+// -----------------------------------------------------------------------------
+// Delta-stepping single-source shortest paths (Meyer & Sanders).
+// Tentative distances are kept in buckets of width delta. The current bucket is
+// emptied in rounds: all of its vertices relax their light arcs (weight <= delta)
+// in parallel, which may refill the same bucket; once it stays empty, the heavy arcs
+// (weight > delta) of every vertex settled in it are relaxed in parallel as well.
+// The constructor copies the CSR arcs with each vertex's light arcs first, so the
+// preprocessing is shared by all run() calls. Edge weights must be non-negative.
+// run() returns the same distances as dijkstra().
+// -----------------------------------------------------------------------------
+class DeltaStepping {
+  public:
+    // delta <= 0 picks max weight / average degree (at least 1).
+    DeltaStepping(const CsrGraph& graph, ThreadPool& pool, int delta = 0)
+        : n(graph.vertexCount), pool(pool) {
+        int arcs = graph.arcCount();
+        offsets.assign(graph.offsets.begin(), graph.offsets.end());
+        targets.resize(arcs);
+        weights.resize(arcs);
+        lightEnd.resize(n + 1);
+
+        if (graph.minWeight < 0) {
+            throw runtime_error("Delta-stepping only for non-negative weights!");
+        }
+        maxWeight = graph.maxWeight;
+        if (delta <= 0) {
+            int averageDegree = max(1, arcs / max(1, n));
+            delta = max(1, maxWeight / averageDegree);
+        }
+        this->delta = delta;
+
+        for (int u = 1; u <= n; u++) {
+            int light = offsets[u];
+            int heavy = offsets[u + 1];
+            for (int a = offsets[u]; a < offsets[u + 1]; a++) {
+                int slot = graph.weights[a] <= delta ? light++ : --heavy;
+                targets[slot] = graph.targets[a];
+                weights[slot] = graph.weights[a];
+            }
+            lightEnd[u] = light;
+        }
+        ringSize = maxWeight / delta + 2;
+    }
+
+    int getDelta() const {
+        return delta;
+    }
+
+    vector<int> run(int start) {
+        vector<atomic<int>> dist(n + 1);
+        for (auto& d : dist) {
+            d.store(INF, memory_order_relaxed);
+        }
+        vector<vector<int>> buckets(ringSize);
+        vector<vector<int>> requests(pool.size());
+        vector<int> roundStamp(n + 1, -1), bucketStamp(n + 1, -1);
+        vector<int> frontier, settled;
+
+        dist[start].store(0, memory_order_relaxed);
+        buckets[0].push_back(start);
+        int round = 0;
+
+        for (int bucket = 0;; bucket++) {
+            // Find the next non-empty bucket; every live entry is within ringSize of it.
+            int skipped = 0;
+            while (skipped < ringSize && buckets[bucket % ringSize].empty()) {
+                bucket++;
+                skipped++;
+            }
+            if (skipped == ringSize) {
+                break;
+            }
+
+            vector<int>& current = buckets[bucket % ringSize];
+            settled.clear();
+            while (!current.empty()) {
+                // Drop stale and duplicate entries.
+                frontier.clear();
+                for (int v : current) {
+                    if (roundStamp[v] != round &&
+                        dist[v].load(memory_order_relaxed) / delta == bucket) {
+                        roundStamp[v] = round;
+                        frontier.push_back(v);
+                        if (bucketStamp[v] != bucket) {
+                            bucketStamp[v] = bucket;
+                            settled.push_back(v);
+                        }
+                    }
+                }
+                current.clear();
+                round++;
+                relax(frontier, true, dist, requests);
+                insertRequests(dist, buckets, requests);
+            }
+            relax(settled, false, dist, requests);
+            insertRequests(dist, buckets, requests);
+        }
+
+        vector<int> result(n + 1);
+        for (int v = 0; v <= n; v++) {
+            result[v] = dist[v].load(memory_order_relaxed);
+        }
+        return result;
+    }
+
+  private:
+    int n;
+    ThreadPool& pool;
+    int delta;
+    int maxWeight;
+    int ringSize;
+    vector<int> offsets;
+    vector<int> targets;
+    vector<int> weights;
+    vector<int> lightEnd;  // arcs [offsets[u], lightEnd[u]) are light, the rest heavy
+
+    // Relaxes the light or heavy arcs of every vertex in `vertices` in parallel.
+    // Vertices whose distance improved are collected per worker in `requests`.
+    void relax(const vector<int>& vertices, bool light, vector<atomic<int>>& dist,
+               vector<vector<int>>& requests) {
+        pool.parallelFor(static_cast<int>(vertices.size()), [&](int i, int worker) {
+            int u = vertices[i];
+            int du = dist[u].load(memory_order_relaxed);
+            int begin = light ? offsets[u] : lightEnd[u];
+            int end = light ? lightEnd[u] : offsets[u + 1];
+            for (int a = begin; a < end; a++) {
+                int v = targets[a];
+                int candidate = WeightTraits<int>::add(du, weights[a]);
+                int old = dist[v].load(memory_order_relaxed);
+                while (candidate < old) {
+                    if (dist[v].compare_exchange_weak(old, candidate, memory_order_relaxed)) {
+                        requests[worker].push_back(v);
+                        break;
+                    }
+                }
+            }
+        }, 64);
+    }
+
+    void insertRequests(vector<atomic<int>>& dist, vector<vector<int>>& buckets,
+                        vector<vector<int>>& requests) {
+        for (auto& list : requests) {
+            for (int v : list) {
+                buckets[dist[v].load(memory_order_relaxed) / delta % ringSize].push_back(v);
+            }
+            list.clear();
+        }
+    }
+};
+
+inline vector<int> deltaStepping(const CsrGraph& graph, int start, ThreadPool& pool, int delta = 0) {
+    DeltaStepping solver(graph, pool, delta);
+    return solver.run(start);
+}
+
+#endif // DELTA_STEPPING_HPP
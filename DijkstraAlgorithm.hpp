@@ -2,58 +2,145 @@
 #define DIJKSTRA_HPP
 
 #include "GraphGenerator.hpp"  // This header defines Graph and GraphInputs.
-#include <queue>
+#include "CsrGraph.hpp"
+#include "PriorityQueues.hpp"
+#include "AlgorithmStats.hpp"
+#include "WeightTraits.hpp"
 #include <vector>
 #include <tuple>
 using namespace std;
 
-const int INF = 1e9;
-
-// Dijkstra algorithm that computes shortest paths from a given start vertex.
-// Assumes the graph is directed (or uses only one direction of edges for undirected graphs).
-// The algorithm first builds an adjacency list from the edge list contained in graph.edges.
-inline vector<int> dijkstra(const Graph &graph, int start) {
-    int n = graph.vertexCount;
-    // Build an adjacency list (1-indexed)
-    vector<vector<pair<int, int>>> adj(n + 1);
-    for (const auto &edge : graph.edges) {
-        int u, v, w;
-        tie(u, v, w) = edge;
-        adj[u].push_back({v, w});
-        if (!graph.isDirected) {
-            adj[v].push_back({u, w});
-        }
-        //   ,  :
-        // adj[v].push_back({u, w});
+const int INF = WeightTraits<int>::infinity();
+
+// Reusable state for repeated Dijkstra runs with W distances. dist holds infinity
+// everywhere except the vertices listed in touched, so preparing the next run costs
+// O(touched) instead of O(n), and the queues keep their capacity between runs.
+template <class W>
+struct BasicDijkstraWorkspace {
+    vector<W> dist;
+    vector<int> touched;
+    BinaryHeapQueue<int, W> heap;
+    DialQueue<int> dial;      // int distances only
+    RadixHeap<int, W> radix;  // integer distances only
+
+    explicit BasicDijkstraWorkspace(int vertexCount = 0) : dist(vertexCount + 1, WeightTraits<W>::infinity()) {}
+
+    void reset() {
+        for (int v : touched)
+            dist[v] = WeightTraits<W>::infinity();
+        touched.clear();
     }
+};
 
-    vector<int> dist(n + 1, INF);
-    dist[start] = 0;
+typedef BasicDijkstraWorkspace<int> DijkstraWorkspace;
 
-    // Min-heap: (distance, vertex)
-    priority_queue<pair<int, int>, vector<pair<int, int>>, greater<pair<int, int>>> pq;
-    pq.push({0, start});
+// Dijkstra algorithm that computes shortest paths from a given start vertex, with the
+// priority queue supplied by the caller (see PriorityQueues.hpp). pq must be empty.
+// Works on a prebuilt CSR graph, so repeated queries on the same graph do not pay for
+// rebuilding the adjacency structure. Undirected edges are followed in both directions.
+// On return ws.dist holds the distances and ws.touched lists every reached vertex.
+// Path lengths are summed with WeightTraits<W>::add(), so they saturate at infinity
+// instead of overflowing. stats counts queue operations and scanned arcs (see
+// AlgorithmStats.hpp).
+template <class W, class Queue, bool Enabled>
+inline void dijkstra(const BasicCsrGraph<W> &graph, int start, BasicDijkstraWorkspace<W> &ws, Queue &pq,
+                     AlgorithmStats<Enabled> &stats) {
+    const W inf = WeightTraits<W>::infinity();
+    if (ws.dist.size() < static_cast<size_t>(graph.vertexCount + 1))
+        ws.dist.resize(graph.vertexCount + 1, inf);
+    ws.reset();
+    stats.beginPhase("dijkstra");
+    vector<W> &dist = ws.dist;
+    dist[start] = 0;
+    ws.touched.push_back(start);
+    pq.push(0, start);
+    stats.count(StatCounter::HeapPushes);
 
     while (!pq.empty()) {
-        auto temp = pq.top();
-        int cur_dist = temp.first;
+        auto temp = pq.pop();
+        W cur_dist = temp.first;
         int u = temp.second;
-        pq.pop();
+        stats.count(StatCounter::HeapPops);
 
         // If the current distance doesn't match the stored distance, skip.
-        if (cur_dist != dist[u])
+        if (cur_dist != dist[u]) {
+            stats.count(StatCounter::StalePops);
             continue;
+        }
 
-        for (auto &edge : adj[u]) {
-            int v = edge.first;
-            int weight = edge.second;
-            if (cur_dist + weight < dist[v]) {
-                dist[v] = cur_dist + weight;
-                pq.push({dist[v], v});
+        stats.count(StatCounter::ArcScans, graph.offsets[u + 1] - graph.offsets[u]);
+        for (int a = graph.offsets[u]; a < graph.offsets[u + 1]; a++) {
+            int v = graph.targets[a];
+            W next = WeightTraits<W>::add(cur_dist, graph.weights[a]);
+            if (next < dist[v]) {
+                if (dist[v] == inf)
+                    ws.touched.push_back(v);
+                dist[v] = next;
+                pq.push(dist[v], v);
+                stats.count(StatCounter::HeapPushes);
             }
         }
     }
-    return dist;
+    stats.endPhase();
+}
+
+template <class W, class Queue>
+inline void dijkstra(const BasicCsrGraph<W> &graph, int start, BasicDijkstraWorkspace<W> &ws, Queue &pq) {
+    dijkstra(graph, start, ws, pq, nullStats());
+}
+
+// Weight types other than int (below): a radix heap for non-negative integer weights
+// and a binary heap otherwise, as the radix heap needs integer keys.
+template <class W, bool Enabled>
+inline void dijkstra(const BasicCsrGraph<W> &graph, int start, BasicDijkstraWorkspace<W> &ws,
+                     AlgorithmStats<Enabled> &stats) {
+    if (is_integral<W>::value && graph.minWeight >= 0) {
+        ws.radix.clear();
+        dijkstra(graph, start, ws, ws.radix, stats);
+    } else {
+        ws.heap.clear();
+        dijkstra(graph, start, ws, ws.heap, stats);
+    }
+}
+
+// Picks the priority queue from the weight range of the graph: Dial buckets for small
+// non-negative weights, a radix heap for larger ones, and a binary heap otherwise.
+template <bool Enabled>
+inline void dijkstra(const CsrGraph &graph, int start, DijkstraWorkspace &ws, AlgorithmStats<Enabled> &stats) {
+    if (graph.minWeight < 0) {
+        ws.heap.clear();
+        dijkstra(graph, start, ws, ws.heap, stats);
+    } else if (graph.maxWeight <= MAX_BUCKET_QUEUE_RANGE) {
+        ws.dial.reset(graph.maxWeight);
+        dijkstra(graph, start, ws, ws.dial, stats);
+    } else {
+        ws.radix.clear();
+        dijkstra(graph, start, ws, ws.radix, stats);
+    }
+}
+
+template <class W>
+inline void dijkstra(const BasicCsrGraph<W> &graph, int start, BasicDijkstraWorkspace<W> &ws) {
+    dijkstra(graph, start, ws, nullStats());
+}
+
+template <class W, bool Enabled>
+inline vector<W> dijkstra(const BasicCsrGraph<W> &graph, int start, AlgorithmStats<Enabled> &stats) {
+    BasicDijkstraWorkspace<W> ws(graph.vertexCount);
+    dijkstra(graph, start, ws, stats);
+    return move(ws.dist);
+}
+
+template <class W>
+inline vector<W> dijkstra(const BasicCsrGraph<W> &graph, int start) {
+    return dijkstra(graph, start, nullStats());
+}
+
+// Convenience overload that builds the CSR graph for a single query.
+// Prefer building the CsrGraph once when running many queries on the same graph.
+template <class W>
+inline vector<W> dijkstra(const BasicGraph<W> &graph, int start) {
+    return dijkstra(buildCsrGraph(graph), start);
 }
 
 #endif // DIJKSTRA_HPP
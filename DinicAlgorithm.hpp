@@ -3,74 +3,237 @@
 
 #include "GraphGenerator.hpp"
 #include "FlowEdge.hpp"
+#include "AlgorithmStats.hpp"
 #include <bits/stdc++.h>
 
-const int INF_3 = 1e9;
-
-class Dinic {
+// -----------------------------------------------------------------------------
+// Dinic's maximum flow. Each phase builds a level graph with a BFS that stops once
+// the sink's level is complete, then saturates it with a blocking flow. The
+// blocking flow is an iterative DFS over the current-arc array `start`: after an
+// augmentation it retreats only to the first saturated arc of the path, so several
+// paths share the walked prefix, and an arc is skipped for good once it leads to a
+// dead end. The BFS queue and the DFS path are preallocated once per solver.
+//
+// With capacityScaling, phases first use only arcs with residual capacity >= delta,
+// for delta = the largest power of two <= the largest capacity, halving delta down
+// to 1; this needs fewer phases when capacities span a wide range.
+//
+// Every call starts from the flow already in the network, so after changing
+// capacities with setCapacity() another maxFlow() call only adds what the change
+// made possible instead of recomputing the flow from zero.
+//
+// Stats receives a "bfs" and a "blockingFlow" phase per phase of every pushFlow()
+// and counts level graphs, scanned arcs and augmenting paths (see
+// AlgorithmStats.hpp); the default NullStats records nothing.
+// -----------------------------------------------------------------------------
+template <class Cap, class Stats = NullStats>
+class BasicDinic {
   private:
-    FlowNetwork& network;
+    BasicFlowNetwork<Cap>& network;
+    Stats& stats;
     int n;
+    bool capacityScaling;
     vector<int> level;
     vector<int> start;
+    vector<int> queue;  // BFS buffer
+    vector<int> path;   // arcs of the current DFS path
+
+    // Arcs with residual capacity >= delta are used; delta 0 allows any positive one.
+    bool usable(int a, Cap delta) const {
+        Cap r = network.residual[a];
+        return r > 0 && r >= delta;
+    }
+
+    int tail(int a) const {
+        return network.head[network.rev[a]];
+    }
 
   public:
-    Dinic(FlowNetwork& network) : network(network), n(network.n) {
+    BasicDinic(BasicFlowNetwork<Cap>& network, bool capacityScaling = false)
+        : BasicDinic(network, nullStats(), capacityScaling) {}
+
+    BasicDinic(BasicFlowNetwork<Cap>& network, Stats& stats, bool capacityScaling = false)
+        : network(network), stats(stats), n(network.n), capacityScaling(capacityScaling) {
         level.resize(n + 1);
         start.resize(n + 1);
+        queue.resize(n + 1);
+        path.reserve(n + 1);
     }
 
-    bool bfs(int s, int t) {
+    // Levels vertices by BFS over usable arcs. Vertices at or beyond the sink's level
+    // are left unexplored.
+    bool bfs(int s, int t, Cap delta = 0) {
         fill(level.begin(), level.end(), -1);
         level[s] = 0;
-        queue<int> q;
-        q.push(s);
-        while (!q.empty()) {
-            int u = q.front();
-            q.pop();
-            for (const auto &edge : network.adj[u]) {
-                if (level[edge.v] < 0 && edge.flow < edge.capacity) {
-                    level[edge.v] = level[u] + 1;
-                    q.push(edge.v);
+        int head = 0, tail = 0;
+        queue[tail++] = s;
+        stats.count(StatCounter::BfsPhases);
+        while (head < tail) {
+            int u = queue[head++];
+            if (level[t] >= 0 && level[u] >= level[t]) {
+                break;
+            }
+            stats.count(StatCounter::ArcScans, network.offsets[u + 1] - network.offsets[u]);
+            for (int a = network.offsets[u]; a < network.offsets[u + 1]; a++) {
+                int v = network.head[a];
+                if (level[v] < 0 && usable(a, delta)) {
+                    level[v] = level[u] + 1;
+                    queue[tail++] = v;
                 }
             }
         }
         return level[t] >= 0;
     }
 
-    int dfs(int u, int t, int flow) {
+    // Pushes a blocking flow of at most limit through the level graph of the last
+    // bfs() call using usable arcs, and returns its value.
+    Cap blockingFlow(int s, int t, Cap delta = 0, Cap limit = numeric_limits<Cap>::max()) {
+        Cap total = 0;
+        path.clear();
+        int u = s;
+        while (true) {
+            if (u == t) {
+                Cap flow = limit - total;
+                for (int a : path) {
+                    flow = min(flow, network.residual[a]);
+                }
+                int retreat = -1;
+                for (int i = 0; i < (int)path.size(); i++) {
+                    int a = path[i];
+                    network.residual[a] -= flow;
+                    network.residual[network.rev[a]] += flow;
+                    if (retreat < 0 && !usable(a, delta)) {
+                        retreat = i;
+                    }
+                }
+                total += flow;
+                stats.count(StatCounter::AugmentingPaths);
+                if (total == limit) {
+                    break;
+                }
+                // Continue from the tail of the first arc that can no longer be used.
+                u = tail(path[retreat]);
+                path.resize(retreat);
+                continue;
+            }
 
-        if (flow == 0) {
-            return 0;
+            bool advanced = false;
+            for (; start[u] < network.offsets[u + 1]; start[u]++) {
+                int a = start[u];
+                int v = network.head[a];
+                if (level[v] == level[u] + 1 && usable(a, delta) && (v == t || level[v] < level[t])) {
+                    path.push_back(a);
+                    u = v;
+                    advanced = true;
+                    break;
+                }
+            }
+            if (!advanced) {
+                // Dead end: no path to t leaves u, so drop the arc that led here.
+                if (path.empty()) {
+                    break;
+                }
+                u = tail(path.back());
+                path.pop_back();
+                start[u]++;
+            }
         }
-        if (u == t) {
-            return flow;
+        return total;
+    }
+
+    // Adds a maximum s-t flow on top of the flow already in the network and returns
+    // the amount added.
+    Cap maxFlow(int s, int t) {
+        if (s == t) {
+            throw runtime_error("Source and sink must differ!");
         }
+        return pushFlow(s, t, numeric_limits<Cap>::max());
+    }
 
-        for (; start[u] < network.adj[u].size(); start[u]++) {
-            FlowEdge& edge = network.adj[u][start[u]];
-            if (level[edge.v] == level[u] + 1 && edge.flow < edge.capacity) {
-                int curr_flow = min(flow, edge.capacity - edge.flow);
-                int temp_flow = dfs(edge.v, t, curr_flow);
-                if (temp_flow > 0) {
-                    edge.flow += temp_flow;
-                    network.adj[edge.v][edge.rev].flow -= temp_flow;
-                    return temp_flow;
+    // Sends up to limit additional units from `from` to `to` along residual paths and
+    // returns the amount sent.
+    Cap pushFlow(int from, int to, Cap limit) {
+        if (from == to || limit <= 0) {
+            return from == to ? limit : 0;
+        }
+        Cap delta = 1;
+        if (capacityScaling) {
+            Cap maxCapacity = 0;
+            for (int a = 0; a < network.arcCount(); a++) {
+                maxCapacity = max(maxCapacity, network.residual[a]);
+            }
+            while (delta <= maxCapacity / 2) {
+                delta *= 2;
+            }
+        }
+        // Scaling phases for delta > 1, then a final phase over every positive residual.
+        stats.beginPhase("dinic");
+        Cap total = 0;
+        for (; ; delta /= 2) {
+            Cap threshold = delta > 1 ? delta : 0;
+            while (total < limit) {
+                stats.beginPhase("bfs");
+                bool reached = bfs(from, to, threshold);
+                stats.endPhase();
+                if (!reached) {
+                    break;
                 }
+                stats.beginPhase("blockingFlow");
+                copy(network.offsets.begin(), network.offsets.end() - 1, start.begin());
+                total += blockingFlow(from, to, threshold, limit - total);
+                stats.endPhase();
+            }
+            if (threshold == 0 || total == limit) {
+                break;
             }
         }
-        return 0;
+        stats.endPhase();
+        return total;
     }
 
-    int maxFlow(int s, int t) {
-        int total = 0;
-        while (bfs(s, t)) {
-            fill(start.begin(), start.end(), 0);
-            while (int flow = dfs(s, t, INF))
-                total += flow;
+    // Net flow into t.
+    Cap flowValue(int t) const {
+        Cap value = 0;
+        for (int a = network.offsets[t]; a < network.offsets[t + 1]; a++) {
+            value -= network.flow(a);
         }
-        return total;
+        return value;
+    }
+
+    // Changes the capacity of the edge with forward arc a (see
+    // BasicFlowNetwork::setCapacity()) while keeping a valid s-t flow. Raising a
+    // capacity keeps the flow as it is. When the flow on an arc u -> v no longer fits,
+    // the cut amount is rerouted from u to v through the residual network; what cannot
+    // be rerouted is returned from u to the source and replaced at v by flow pulled
+    // back from the sink. Returns the change of the flow value (zero or negative); a
+    // following maxFlow() call adds whatever the new capacities allow.
+    Cap setCapacity(int a, Cap capacity, int s, int t) {
+        Cap before = flowValue(t);
+        pair<int, Cap> cut = network.setCapacity(a, capacity);
+        if (cut.first < 0) {
+            return 0;
+        }
+        int u = tail(cut.first);
+        int v = network.head[cut.first];
+        Cap rest = cut.second - pushFlow(u, v, cut.second);
+        if (rest > 0) {
+            // Excess left at u goes back to the source (or on to the sink), and the
+            // flow missing at v is taken from the sink (or else from the source).
+            Cap excessLeft = rest;
+            if (u != s && u != t) {
+                excessLeft -= pushFlow(u, s, excessLeft);
+                pushFlow(u, t, excessLeft);
+            }
+            Cap deficitLeft = rest;
+            if (v != s && v != t) {
+                deficitLeft -= pushFlow(t, v, deficitLeft);
+                pushFlow(s, v, deficitLeft);
+            }
+        }
+        return flowValue(t) - before;
     }
 };
 
+typedef BasicDinic<long long> Dinic;
+
 #endif // DINIC_ALGORITHM_HPP
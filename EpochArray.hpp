@@ -0,0 +1,68 @@
+#ifndef EPOCH_ARRAY_HPP
+#define EPOCH_ARRAY_HPP
+
+#include <algorithm>
+#include <cstdint>
+#include <vector>
+using namespace std;
+
+// -----------------------------------------------------------------------------
+// Array whose entries all return to an initial value in O(1). Every entry carries
+// the epoch it was last written in, and an entry of an older epoch reads as the
+// initial value, so reset() only starts a new epoch. The stamp is stored next to
+// the value, so a lookup touches one cache line. Once every 2^32 resets the stamps
+// are cleared for real. Workspaces of repeated searches use it for visited marks and
+// parent pointers instead of refilling O(n) arrays on every call.
+// -----------------------------------------------------------------------------
+template <class T>
+class EpochArray {
+  public:
+    explicit EpochArray(size_t size = 0, const T& initial = T()) : initial(initial), epoch(1) {
+        resize(size);
+    }
+
+    // Grows to at least size entries; entries never shrink, so capacity is kept.
+    void resize(size_t size) {
+        if (size > entries.size()) {
+            entries.resize(size, Entry{0, initial});
+        }
+    }
+
+    size_t size() const {
+        return entries.size();
+    }
+
+    void reset() {
+        if (++epoch == 0) {
+            for (Entry& entry : entries) {
+                entry.stamp = 0;
+            }
+            epoch = 1;
+        }
+    }
+
+    bool isSet(size_t i) const {
+        return entries[i].stamp == epoch;
+    }
+
+    T get(size_t i) const {
+        return entries[i].stamp == epoch ? entries[i].value : initial;
+    }
+
+    void set(size_t i, const T& value) {
+        entries[i].stamp = epoch;
+        entries[i].value = value;
+    }
+
+  private:
+    struct Entry {
+        uint32_t stamp;
+        T value;
+    };
+
+    vector<Entry> entries;
+    T initial;
+    uint32_t epoch;
+};
+
+#endif // EPOCH_ARRAY_HPP
@@ -1,46 +1,209 @@
 #ifndef FLOW_EDGE_HPP
 #define FLOW_EDGE_HPP
 
-struct FlowEdge {
-    int u, v;
-    int capacity;
-    int flow;
-    int rev;
-};
+#include "CsrGraph.hpp"
 
-class FlowNetwork {
+// -----------------------------------------------------------------------------
+// Residual network packed in CSR form (structure of arrays). The arcs leaving u
+// occupy [offsets[u], offsets[u + 1]); for arc a, head[a] is its target, rev[a] the
+// index of the paired reverse arc, capacity[a] its capacity and residual[a] its
+// remaining capacity, so the flow on a is capacity[a] - residual[a]. A directed edge
+// adds an arc and a reverse arc of capacity 0; an undirected edge adds two arcs with
+// the full capacity. edgeArcs[i] is the forward arc of the i-th edge in build order.
+// Networks built with edge costs also have cost[a], the cost per unit of flow on a,
+// with cost[rev[a]] == -cost[a]; cost is empty otherwise.
+//
+// Cap is the capacity and flow type; FlowNetwork uses 64-bit capacities so that
+// summed flows cannot overflow.
+// -----------------------------------------------------------------------------
+template <class Cap>
+class BasicFlowNetwork {
   public:
     int n;
-    vector<vector<FlowEdge>> adj;
+    bool isDirected;
+    vector<int> offsets;
+    vector<int> head;
+    vector<int> rev;
+    vector<Cap> capacity;
+    vector<Cap> residual;
+    vector<int> edgeArcs;
+    vector<long long> cost;
+
+    explicit BasicFlowNetwork(int n = 0, bool isDirected = true)
+        : n(n), isDirected(isDirected), offsets(n + 2, 0) {}
+
+    int arcCount() const {
+        return static_cast<int>(head.size());
+    }
+
+    Cap flow(int a) const {
+        return capacity[a] - residual[a];
+    }
+
+    bool hasCosts() const {
+        return cost.size() == head.size();
+    }
+
+    // Total cost of the flow in the network; the network must have costs.
+    long long flowCost() const {
+        if (!hasCosts()) {
+            throw runtime_error("Network has no costs!");
+        }
+        long long total = 0;
+        for (int a : edgeArcs) {
+            total += static_cast<long long>(flow(a)) * cost[a];
+        }
+        return total;
+    }
 
-    FlowNetwork(int n) : n(n) {
-        adj.resize(n + 1);
+    // Removes all flow, restoring every residual capacity to the arc's capacity.
+    void resetFlow() {
+        residual = capacity;
     }
 
-    void addEdge(int u, int v, int capacity, bool isDirected) {
-        FlowEdge a, b;
-        if (isDirected) {
-            a = {u, v, capacity, 0, (int)adj[v].size()};
-            b = {v, u, 0, 0, (int)adj[u].size()};
-        } else {
-            a = {u, v, capacity, 0, (int)adj[v].size()};
-            b = {v, u, capacity, 0, (int)adj[u].size()};
+    // Sets the capacity of the edge whose forward arc is a (of both its arcs when the
+    // network is undirected) and keeps its flow where it still fits. Otherwise the
+    // flow is cut down to the new capacity and the arc it was cut on is returned with
+    // the amount, which is now excess at the arc's tail and missing at its head; see
+    // BasicDinic::setCapacity() for the repair. Returns (-1, 0) when nothing was cut.
+    pair<int, Cap> setCapacity(int a, Cap newCapacity) {
+        int b = rev[a];
+        Cap f = flow(a);
+        capacity[a] = newCapacity;
+        if (!isDirected) {
+            capacity[b] = newCapacity;
+        }
+        pair<int, Cap> cut(-1, 0);
+        if (f > capacity[a]) {
+            cut = make_pair(a, f - capacity[a]);
+            f = capacity[a];
+        } else if (-f > capacity[b]) {
+            cut = make_pair(b, -f - capacity[b]);
+            f = -capacity[b];
         }
-        adj[u].push_back(a);
-        adj[v].push_back(b);
+        residual[a] = capacity[a] - f;
+        residual[b] = capacity[b] + f;
+        return cut;
     }
 };
 
-inline FlowNetwork buildFlowNetwork(const Graph& graph) {
-    int n = graph.vertexCount;
-    FlowNetwork network(n);
+typedef BasicFlowNetwork<long long> FlowNetwork;
+
+// Builds a network in two passes over the edges, so every array is allocated exactly
+// once: count(u, v) for every edge, then allocate(), then place(u, v, capacity) for
+// the same edges in the same order, then finish(). With withCosts, place() also
+// records the cost of each edge.
+template <class Cap>
+class FlowNetworkBuilder {
+  public:
+    FlowNetworkBuilder(int n, bool isDirected, bool withCosts = false)
+        : network(n, isDirected), edgeCount(0), withCosts(withCosts) {}
+
+    void count(int u, int v) {
+        network.offsets[u + 1]++;
+        network.offsets[v + 1]++;
+        edgeCount++;
+    }
+
+    void allocate() {
+        int n = network.n;
+        for (int u = 1; u <= n + 1; u++) {
+            network.offsets[u] += network.offsets[u - 1];
+        }
+        int arcs = network.offsets[n + 1];
+        network.head.resize(arcs);
+        network.rev.resize(arcs);
+        network.capacity.resize(arcs);
+        if (withCosts) {
+            network.cost.resize(arcs);
+        }
+        network.edgeArcs.reserve(edgeCount);
+        next.assign(network.offsets.begin(), network.offsets.end() - 1);
+    }
+
+    void place(int u, int v, Cap capacity, long long cost = 0) {
+        int a = next[u]++;
+        int b = next[v]++;
+        network.head[a] = v;
+        network.head[b] = u;
+        network.rev[a] = b;
+        network.rev[b] = a;
+        network.capacity[a] = capacity;
+        network.capacity[b] = network.isDirected ? 0 : capacity;
+        if (withCosts) {
+            network.cost[a] = cost;
+            network.cost[b] = -cost;
+        }
+        network.edgeArcs.push_back(a);
+    }
+
+    BasicFlowNetwork<Cap> finish() {
+        network.residual = network.capacity;
+        return move(network);
+    }
+
+  private:
+    BasicFlowNetwork<Cap> network;
+    int edgeCount;
+    bool withCosts;
+    vector<int> next;
+};
+
+template <class Cap = long long>
+BasicFlowNetwork<Cap> buildFlowNetwork(const Graph& graph) {
+    FlowNetworkBuilder<Cap> builder(graph.vertexCount, graph.isDirected);
+    for (const auto &edge : graph.edges) {
+        builder.count(get<0>(edge), get<1>(edge));
+    }
+    builder.allocate();
     for (const auto &edge : graph.edges) {
-        int u, v, capacity;
-        tie(u, v, capacity) = edge;
-        network.addEdge(u, v, capacity, graph.isDirected);
+        builder.place(get<0>(edge), get<1>(edge), get<2>(edge));
     }
-    return network;
+    return builder.finish();
 }
 
-#endif // FLOW_EDGE_HPP
+// Builds a network with edge costs for min-cost flow: the weight of the i-th edge of
+// graph is its capacity and costs[i] its cost per unit of flow.
+template <class Cap = long long>
+BasicFlowNetwork<Cap> buildFlowNetwork(const Graph& graph, const vector<int>& costs) {
+    if (costs.size() != graph.edges.size()) {
+        throw runtime_error("One cost per edge required!");
+    }
+    FlowNetworkBuilder<Cap> builder(graph.vertexCount, graph.isDirected, true);
+    for (const auto &edge : graph.edges) {
+        builder.count(get<0>(edge), get<1>(edge));
+    }
+    builder.allocate();
+    for (size_t i = 0; i < graph.edges.size(); i++) {
+        builder.place(get<0>(graph.edges[i]), get<1>(graph.edges[i]), get<2>(graph.edges[i]), costs[i]);
+    }
+    return builder.finish();
+}
+
+// Builds the flow network from a prebuilt CSR graph. For undirected graphs every edge
+// is stored as two arcs in the CSR arrays, so only the arc with u < v is used.
+template <class Cap = long long>
+BasicFlowNetwork<Cap> buildFlowNetwork(const CsrGraph& graph) {
+    FlowNetworkBuilder<Cap> builder(graph.vertexCount, graph.isDirected);
+    for (int pass = 0; pass < 2; pass++) {
+        for (int u = 1; u <= graph.vertexCount; u++) {
+            for (int a = graph.offsets[u]; a < graph.offsets[u + 1]; a++) {
+                int v = graph.targets[a];
+                if (!graph.isDirected && v <= u) {
+                    continue;
+                }
+                if (pass == 0) {
+                    builder.count(u, v);
+                } else {
+                    builder.place(u, v, graph.weights[a]);
+                }
+            }
+        }
+        if (pass == 0) {
+            builder.allocate();
+        }
+    }
+    return builder.finish();
+}
 
+#endif // FLOW_EDGE_HPP
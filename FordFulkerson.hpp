@@ -3,64 +3,103 @@
 
 #include <bits/stdc++.h>
 #include "FlowEdge.hpp"
+#include "AlgorithmStats.hpp"
+#include "EpochArray.hpp"
 
-const int INF_2 = 1e9;
+// BFS state of edmondsKarp(), reusable across calls. parentArc is epoch-stamped, so
+// each search starts in O(1) instead of clearing an array of n entries.
+struct EdmondsKarpWorkspace {
+    EpochArray<int> parentArc;
+    vector<int> queue;
 
+    void prepare(int n) {
+        parentArc.resize(n + 1);
+        if (queue.size() < static_cast<size_t>(n + 1)) {
+            queue.resize(n + 1);
+        }
+    }
+};
 
-inline int edmondsKarp(FlowNetwork& network, int source, int sink) {
-    int max_flow = 0;
+// Edmonds-Karp: augments along shortest residual paths found by BFS. The BFS
+// buffers come from ws and are reused by every augmentation, so calls with the same
+// workspace allocate nothing once it has grown to the network. stats counts the
+// searches, scanned arcs and augmenting paths (see AlgorithmStats.hpp).
+template <class Cap, bool Enabled>
+Cap edmondsKarp(BasicFlowNetwork<Cap>& network, int source, int sink, EdmondsKarpWorkspace& ws,
+                AlgorithmStats<Enabled>& stats) {
+    if (source == sink) {
+        throw runtime_error("Source and sink must differ!");
+    }
+    stats.beginPhase("edmondsKarp");
+    Cap max_flow = 0;
+    ws.prepare(network.n);
+    EpochArray<int>& parentArc = ws.parentArc;
+    vector<int>& q = ws.queue;
 
     while(true) {
-        vector<int> parent(network.n + 1, -1);
-        vector<int> parentEdge(network.n + 1, -1);
-        queue<int> q;
-
-        q.push(source);
-        parent[source] = source;
-
-        while (!q.empty() && parent[sink] == -1) {
-            int u = q.front();
-            q.pop();
-            for (int i = 0; i < network.adj[u].size(); i++) {
-                FlowEdge& e= network.adj[u][i];
-
-                if (parent[e.v] == -1 && (e.capacity - e.flow) > 0) {
-                    parent[e.v] = u;
-                    parentEdge[e.v] = i;
-                    q.push(e.v);
+        parentArc.reset();
+        parentArc.set(source, network.arcCount());
+        int head = 0, tail = 0;
+        q[tail++] = source;
+        stats.count(StatCounter::BfsPhases);
+
+        while (head < tail && !parentArc.isSet(sink)) {
+            int u = q[head++];
+            stats.count(StatCounter::ArcScans, network.offsets[u + 1] - network.offsets[u]);
+            for (int a = network.offsets[u]; a < network.offsets[u + 1]; a++) {
+                int v = network.head[a];
+
+                if (!parentArc.isSet(v) && network.residual[a] > 0) {
+                    parentArc.set(v, a);
+                    q[tail++] = v;
                 }
             }
         }
 
-        if (parent[sink] == -1) {
+        if (!parentArc.isSet(sink)) {
             break;
         }
 
-        int path_flow = INF_2;
+        Cap path_flow = numeric_limits<Cap>::max();
         int v = sink;
 
         while (v != source) {
-            int u = parent[v];
-            int idx = parentEdge[v];
-            FlowEdge& e = network.adj[u][idx];
-            path_flow = min(path_flow, e.capacity - e.flow);
-            v = u;
+            int a = parentArc.get(v);
+            path_flow = min(path_flow, network.residual[a]);
+            v = network.head[network.rev[a]];
         }
 
         v = sink;
         while (v != source) {
-            int u = parent[v];
-            int idx = parentEdge[v];
-            FlowEdge &e = network.adj[u][idx];
-            e.flow += path_flow;
+            int a = parentArc.get(v);
+            network.residual[a] -= path_flow;
             //   .
-            network.adj[v][e.rev].flow -= path_flow;
-            v = u;
+            network.residual[network.rev[a]] += path_flow;
+            v = network.head[network.rev[a]];
         }
 
         max_flow += path_flow;
+        stats.count(StatCounter::AugmentingPaths);
     }
+    stats.endPhase();
     return max_flow;
 }
 
+template <class Cap, bool Enabled>
+Cap edmondsKarp(BasicFlowNetwork<Cap>& network, int source, int sink, AlgorithmStats<Enabled>& stats) {
+    EdmondsKarpWorkspace ws;
+    return edmondsKarp(network, source, sink, ws, stats);
+}
+
+template <class Cap>
+Cap edmondsKarp(BasicFlowNetwork<Cap>& network, int source, int sink, EdmondsKarpWorkspace& ws) {
+    return edmondsKarp(network, source, sink, ws, nullStats());
+}
+
+template <class Cap>
+Cap edmondsKarp(BasicFlowNetwork<Cap>& network, int source, int sink) {
+    EdmondsKarpWorkspace ws;
+    return edmondsKarp(network, source, sink, ws, nullStats());
+}
+
 #endif // FORD_FULKERSON_HPP
@@ -0,0 +1,106 @@
+#ifndef GOMORY_HU_TREE_HPP
+#define GOMORY_HU_TREE_HPP
+
+#include "GraphGenerator.hpp"
+#include "FlowEdge.hpp"
+#include "PushRelabelAlgorithm.hpp"
+#include "ThreadPool.hpp"
+#include <bits/stdc++.h>
+
+// -----------------------------------------------------------------------------
+// Gomory-Hu (equivalent flow) tree of an undirected network by Gusfield's algorithm:
+// the minimum cut between any two vertices is the lightest edge on their tree path,
+// so after n - 1 maximum flow computations every pair is answered in O(path length).
+//
+// Vertex 1 is the root. Step s (s = 2..n) computes a minimum cut between s and its
+// current parent p[s] and hangs every later vertex on the s-side that shares s's
+// parent below s. Each step uses PushRelabel::minCutValue() on a network copy whose
+// flow is reset instead of rebuilt.
+//
+// The steps run in speculative waves of pool.size() consecutive vertices, one per
+// worker and network copy, each against the parent it has when the wave starts. The
+// cut of step s depends only on s and p[s], so the results are then applied in order
+// and accepted as long as p[s] is still the parent the cut was computed for; the
+// wave stops at the first step whose parent an earlier step changed, and the next
+// wave starts there. The tree is therefore the sequential one for any thread count.
+// -----------------------------------------------------------------------------
+template <class Cap>
+class BasicGomoryHuTree {
+  public:
+    BasicGomoryHuTree(const BasicFlowNetwork<Cap>& network, ThreadPool& pool)
+        : n(network.n), parent(network.n + 1, 1), weight(network.n + 1, 0), depth(network.n + 1, 0) {
+        if (network.isDirected) {
+            throw runtime_error("Gomory-Hu tree only for undirected!");
+        }
+        int workers = pool.size();
+        vector<BasicFlowNetwork<Cap>> copies(workers, network);
+        vector<BasicPushRelabel<Cap>> solvers;
+        solvers.reserve(workers);
+        for (auto& copy : copies) {
+            solvers.emplace_back(copy);
+        }
+        vector<int> sink(workers);
+        vector<Cap> value(workers);
+        vector<vector<int>> side(workers);
+
+        for (int next = 2; next <= n; ) {
+            int wave = min(workers, n - next + 1);
+            for (int i = 0; i < wave; i++) {
+                sink[i] = parent[next + i];
+            }
+            pool.parallelFor(wave, [&](int i, int worker) {
+                copies[worker].resetFlow();
+                value[i] = solvers[worker].minCutValue(next + i, sink[i]);
+                side[i] = solvers[worker].minCutSourceSide();
+            });
+            for (int i = 0; i < wave && parent[next] == sink[i]; i++, next++) {
+                int s = next;
+                weight[s] = value[i];
+                for (int v : side[i]) {
+                    if (v > s && parent[v] == sink[i]) {
+                        parent[v] = s;
+                    }
+                }
+            }
+        }
+        // Every parent has a smaller index, so one pass in vertex order sets the depths.
+        for (int v = 2; v <= n; v++) {
+            depth[v] = depth[parent[v]] + 1;
+        }
+    }
+
+    // Minimum cut value between u and v: the lightest edge on their tree path.
+    Cap minCut(int u, int v) const {
+        if (u == v) {
+            throw runtime_error("Source and sink must differ!");
+        }
+        Cap best = numeric_limits<Cap>::max();
+        while (u != v) {
+            if (depth[u] < depth[v]) {
+                swap(u, v);
+            }
+            best = min(best, weight[u]);
+            u = parent[u];
+        }
+        return best;
+    }
+
+    // Tree edge from v (v >= 2) to its parent and the cut value on it.
+    int parentOf(int v) const {
+        return parent[v];
+    }
+
+    Cap weightOf(int v) const {
+        return weight[v];
+    }
+
+  private:
+    int n;
+    vector<int> parent;
+    vector<Cap> weight;  // minimum cut between v and parent[v]
+    vector<int> depth;
+};
+
+typedef BasicGomoryHuTree<long long> GomoryHuTree;
+
+#endif // GOMORY_HU_TREE_HPP
@@ -0,0 +1,604 @@
+#ifndef GRAPH_FILE_HPP
+#define GRAPH_FILE_HPP
+
+#include "CsrGraph.hpp"
+#include "ThreadPool.hpp"
+#include <bits/stdc++.h>
+#include <fcntl.h>
+#include <sys/mman.h>
+#include <sys/stat.h>
+#include <unistd.h>
+
+// -----------------------------------------------------------------------------
+// Graph files.
+//
+// The binary CSR format stores a CsrGraph exactly as it is laid out in memory: a
+// 40-byte header (magic "GRCS", version, a byte-order mark, vertex count, directed
+// flag, smallest and largest weight, and the 64-bit arc count) followed by the
+// int32 arrays offsets[n + 2], targets[arcs] and weights[arcs]. Every array starts
+// at a multiple of 4 bytes, so mapCsrGraph() maps the file read-only and points the
+// graph's arrays into the mapping instead of copying it. It validates the arrays in
+// one pass unless asked not to, in which case pages are loaded on first access.
+//
+// readDimacs() and readEdgeList() parse text files in parallel: the mapped text is
+// cut into chunks at line boundaries, every chunk is parsed into its own edge arrays,
+// and the CSR graph is built from the chunks in file order, so the result does not
+// depend on the thread count. Arcs of each vertex keep the order of the file.
+// -----------------------------------------------------------------------------
+
+const char CSR_FILE_MAGIC[] = "GRCS";
+const int32_t CSR_FILE_VERSION = 1;
+const int32_t CSR_FILE_BYTE_ORDER = 0x01020304;
+const size_t TEXT_CHUNK_BYTES = 1 << 22;
+
+struct CsrFileHeader {
+    char magic[4];
+    int32_t version;
+    int32_t byteOrder;
+    int32_t vertexCount;
+    int32_t isDirected;
+    int32_t minWeight;
+    int32_t maxWeight;
+    int32_t reserved;
+    int64_t arcCount;
+};
+
+static_assert(sizeof(CsrFileHeader) == 40, "CSR file header must be 40 bytes");
+
+// Read-only mapping of a whole file, unmapped on destruction.
+class MappedFile {
+  public:
+    explicit MappedFile(const string& path) : data_(nullptr), size_(0) {
+        int fd = open(path.c_str(), O_RDONLY);
+        if (fd < 0) {
+            throw runtime_error("Cannot open " + path + "!");
+        }
+        struct stat info;
+        if (fstat(fd, &info) != 0) {
+            close(fd);
+            throw runtime_error("Cannot read " + path + "!");
+        }
+        size_ = info.st_size;
+        if (size_ > 0) {
+            void* mapping = mmap(nullptr, size_, PROT_READ, MAP_PRIVATE, fd, 0);
+            if (mapping == MAP_FAILED) {
+                close(fd);
+                throw runtime_error("Cannot map " + path + "!");
+            }
+            data_ = static_cast<char*>(mapping);
+        }
+        close(fd);
+    }
+
+    ~MappedFile() {
+        if (data_ != nullptr) {
+            munmap(data_, size_);
+        }
+    }
+
+    MappedFile(const MappedFile&) = delete;
+    MappedFile& operator=(const MappedFile&) = delete;
+
+    const char* data() const { return data_; }
+    size_t size() const { return size_; }
+
+    // Hints that the file will be read front to back.
+    void adviseSequential() const {
+        if (data_ != nullptr) {
+            madvise(data_, size_, MADV_SEQUENTIAL);
+        }
+    }
+
+  private:
+    char* data_;
+    size_t size_;
+};
+
+// Writes the graph in the binary CSR format.
+inline void saveCsrGraph(const CsrGraph& graph, const string& path) {
+    ofstream out(path, ios::binary);
+    if (!out) {
+        throw runtime_error("Cannot open " + path + " for writing!");
+    }
+    CsrFileHeader header;
+    copy(CSR_FILE_MAGIC, CSR_FILE_MAGIC + 4, header.magic);
+    header.version = CSR_FILE_VERSION;
+    header.byteOrder = CSR_FILE_BYTE_ORDER;
+    header.vertexCount = graph.vertexCount;
+    header.isDirected = graph.isDirected;
+    header.minWeight = graph.minWeight;
+    header.maxWeight = graph.maxWeight;
+    header.reserved = 0;
+    header.arcCount = graph.arcCount();
+    out.write(reinterpret_cast<const char*>(&header), sizeof(header));
+    out.write(reinterpret_cast<const char*>(graph.offsets.data()), graph.offsets.size() * sizeof(int));
+    out.write(reinterpret_cast<const char*>(graph.targets.data()), graph.targets.size() * sizeof(int));
+    out.write(reinterpret_cast<const char*>(graph.weights.data()), graph.weights.size() * sizeof(int));
+    if (!out) {
+        throw runtime_error("Failed to write " + path + "!");
+    }
+}
+
+// Whether the offsets of graph are monotone, every target lies in [1, vertexCount]
+// and every weight in [minWeight, maxWeight].
+inline bool isValidCsrGraph(const CsrGraph& graph) {
+    int n = graph.vertexCount;
+    for (int u = 0; u <= n; u++) {
+        if (graph.offsets[u] > graph.offsets[u + 1]) {
+            return false;
+        }
+    }
+    for (int a = 0; a < graph.arcCount(); a++) {
+        int v = graph.targets[a];
+        int w = graph.weights[a];
+        if (v < 1 || v > n || w < graph.minWeight || w > graph.maxWeight) {
+            return false;
+        }
+    }
+    return true;
+}
+
+// Opens a binary CSR file without copying it: the arrays of the returned graph view
+// the mapping, which stays alive as long as the graph or a graph moved from it.
+// The mapping is read-only, so writing into a viewed array faults; copying the graph
+// gives an ordinary one that owns its arrays.
+//
+// With validate, one pass over the arrays checks that the offsets are monotone, every
+// target is a vertex and every weight lies within the header's weight range (which
+// sizes the Dial buckets of dijkstra()), so a corrupted file cannot make an algorithm
+// read or write out of bounds. Without it only the header and the ends of the offsets
+// are checked and opening does not touch the arrays; use that for trusted files.
+inline CsrGraph mapCsrGraph(const string& path, bool validate = true) {
+    shared_ptr<MappedFile> file = make_shared<MappedFile>(path);
+    CsrFileHeader header;
+    if (file->size() < sizeof(header)) {
+        throw runtime_error(path + " is not a CSR graph file!");
+    }
+    memcpy(&header, file->data(), sizeof(header));
+    if (!equal(header.magic, header.magic + 4, CSR_FILE_MAGIC)) {
+        throw runtime_error(path + " is not a CSR graph file!");
+    }
+    if (header.version != CSR_FILE_VERSION || header.byteOrder != CSR_FILE_BYTE_ORDER) {
+        throw runtime_error("Unsupported CSR graph version in " + path + "!");
+    }
+    int n = header.vertexCount;
+    int64_t arcs = header.arcCount;
+    if (n < 0 || n > INT_MAX - 2 || arcs < 0 || arcs > INT_MAX ||
+        static_cast<int64_t>(file->size()) !=
+            static_cast<int64_t>(sizeof(header)) + (static_cast<int64_t>(n) + 2 + 2 * arcs) * 4) {
+        throw runtime_error("Truncated CSR graph file " + path + "!");
+    }
+
+    // CsrArray views mutable memory; the pages themselves stay read-only.
+    int* arrays = const_cast<int*>(reinterpret_cast<const int*>(file->data() + sizeof(header)));
+    CsrGraph graph;
+    graph.vertexCount = n;
+    graph.isDirected = header.isDirected != 0;
+    graph.minWeight = header.minWeight;
+    graph.maxWeight = header.maxWeight;
+    graph.offsets = CsrArray<int>::view(arrays, n + 2);
+    graph.targets = CsrArray<int>::view(arrays + n + 2, arcs);
+    graph.weights = CsrArray<int>::view(arrays + n + 2 + arcs, arcs);
+    graph.storage = file;
+    if (graph.offsets[0] != 0 || graph.offsets[n + 1] != arcs || (validate && !isValidCsrGraph(graph))) {
+        throw runtime_error("Inconsistent CSR graph file " + path + "!");
+    }
+    return graph;
+}
+
+// Edges parsed from one chunk of a text file, with their smallest and largest vertex
+// and weight. problemVertices is the vertex count of a DIMACS problem line in the
+// chunk (-1 if none) and errorAt the file offset of the first malformed line (-1 if
+// none).
+struct TextEdgeChunk {
+    vector<int> sources;
+    vector<int> targets;
+    vector<int> weights;
+    long long firstVertex = LLONG_MAX;
+    long long lastVertex = LLONG_MIN;
+    int minWeight = INT_MAX;
+    int maxWeight = INT_MIN;
+    long long problemVertices = -1;
+    long long errorAt = -1;
+
+    void reserve(size_t edges) {
+        sources.reserve(edges);
+        targets.reserve(edges);
+        weights.reserve(edges);
+    }
+
+    void add(long long u, long long v, long long w) {
+        sources.push_back(static_cast<int>(u));
+        targets.push_back(static_cast<int>(v));
+        weights.push_back(static_cast<int>(w));
+        firstVertex = min(firstVertex, min(u, v));
+        lastVertex = max(lastVertex, max(u, v));
+        minWeight = min(minWeight, static_cast<int>(w));
+        maxWeight = max(maxWeight, static_cast<int>(w));
+    }
+};
+
+// Skips blanks and parses a decimal integer ending at a blank or at end. Rejects
+// values beyond 64-bit int range well before they could overflow.
+inline bool parseTextInteger(const char*& p, const char* end, long long& value) {
+    while (p < end && (*p == ' ' || *p == '\t' || *p == '\r')) {
+        p++;
+    }
+    bool negative = p < end && *p == '-';
+    if (p < end && (*p == '-' || *p == '+')) {
+        p++;
+    }
+    if (p == end || *p < '0' || *p > '9') {
+        return false;
+    }
+    value = 0;
+    for (int digits = 0; p < end && *p >= '0' && *p <= '9'; p++, digits++) {
+        if (digits == 18) {
+            return false;
+        }
+        value = value * 10 + (*p - '0');
+    }
+    if (negative) {
+        value = -value;
+    }
+    return p == end || *p == ' ' || *p == '\t' || *p == '\r';
+}
+
+inline bool onlyBlanks(const char* p, const char* end) {
+    for (; p < end; p++) {
+        if (*p != ' ' && *p != '\t' && *p != '\r') {
+            return false;
+        }
+    }
+    return true;
+}
+
+inline bool fitsInt(long long value) {
+    return value >= INT_MIN && value <= INT_MAX;
+}
+
+// Parses one DIMACS line: "c ..." comments, the problem line "p <type> n m", arcs
+// "a u v w", and max-flow terminal lines "n id s|t", which are ignored.
+inline bool parseDimacsLine(const char* p, const char* end, TextEdgeChunk& chunk) {
+    while (p < end && (*p == ' ' || *p == '\t' || *p == '\r')) {
+        p++;
+    }
+    if (p == end || *p == 'c' || *p == 'n') {
+        return true;
+    }
+    char kind = *p++;
+    long long u, v, w;
+    if (kind == 'a') {
+        if (!parseTextInteger(p, end, u) || !parseTextInteger(p, end, v) ||
+            !parseTextInteger(p, end, w) || !fitsInt(w) || !onlyBlanks(p, end)) {
+            return false;
+        }
+        chunk.add(u, v, w);
+        return true;
+    }
+    if (kind == 'p') {
+        while (p < end && (*p == ' ' || *p == '\t')) {
+            p++;
+        }
+        while (p < end && *p != ' ' && *p != '\t') {
+            p++;
+        }
+        if (!parseTextInteger(p, end, u) || !parseTextInteger(p, end, v) || u < 0 || !onlyBlanks(p, end)) {
+            return false;
+        }
+        chunk.problemVertices = u;
+        return true;
+    }
+    return false;
+}
+
+// Parses one edge-list line "u v [w]" (weight 1 by default); '#' and '%' start
+// comment lines. Vertex ids are shifted so that firstId becomes vertex 1.
+inline bool parseEdgeListLine(const char* p, const char* end, int firstId, TextEdgeChunk& chunk) {
+    while (p < end && (*p == ' ' || *p == '\t' || *p == '\r')) {
+        p++;
+    }
+    if (p == end || *p == '#' || *p == '%') {
+        return true;
+    }
+    long long u, v, w = 1;
+    if (!parseTextInteger(p, end, u) || !parseTextInteger(p, end, v)) {
+        return false;
+    }
+    if (!onlyBlanks(p, end) && (!parseTextInteger(p, end, w) || !fitsInt(w) || !onlyBlanks(p, end))) {
+        return false;
+    }
+    chunk.add(u - firstId + 1, v - firstId + 1, w);
+    return true;
+}
+
+// Cuts the mapped text into chunks of about TEXT_CHUNK_BYTES that start at line
+// beginnings and calls parseLine(begin, end, chunk) on every line of each chunk in
+// parallel.
+template <class ParseLine>
+vector<TextEdgeChunk> parseTextChunks(const MappedFile& file, ThreadPool& pool, ParseLine parseLine) {
+    const char* text = file.data();
+    size_t size = file.size();
+    vector<size_t> starts(1, 0);
+    for (size_t at = TEXT_CHUNK_BYTES; at < size; at += TEXT_CHUNK_BYTES) {
+        const char* newline = static_cast<const char*>(memchr(text + at - 1, '\n', size - at + 1));
+        if (newline == nullptr) {
+            break;
+        }
+        size_t start = newline - text + 1;
+        if (start > starts.back() && start < size) {
+            starts.push_back(start);
+        }
+        at = max(at, start);
+    }
+    starts.push_back(size);
+
+    int chunkCount = static_cast<int>(starts.size()) - 1;
+    vector<TextEdgeChunk> chunks(chunkCount);
+    pool.parallelFor(chunkCount, [&](int c, int) {
+        TextEdgeChunk& chunk = chunks[c];
+        // No DIMACS arc line is shorter than 8 bytes; pages never written stay
+        // unallocated.
+        chunk.reserve((starts[c + 1] - starts[c]) / 8);
+        const char* p = text + starts[c];
+        const char* end = text + starts[c + 1];
+        while (p < end && chunk.errorAt < 0) {
+            const char* lineEnd = static_cast<const char*>(memchr(p, '\n', end - p));
+            if (lineEnd == nullptr) {
+                lineEnd = end;
+            }
+            if (!parseLine(p, lineEnd, chunk)) {
+                chunk.errorAt = p - text;
+            }
+            p = lineEnd + 1;
+        }
+    });
+    return chunks;
+}
+
+// Throws for the first malformed line, reporting its line number.
+inline void checkTextChunks(const vector<TextEdgeChunk>& chunks, const MappedFile& file, const string& path) {
+    for (const TextEdgeChunk& chunk : chunks) {
+        if (chunk.errorAt >= 0) {
+            long long line = 1 + count(file.data(), file.data() + chunk.errorAt, '\n');
+            throw runtime_error("Malformed line " + to_string(line) + " in " + path + "!");
+        }
+    }
+}
+
+// An arc of the parsed edges, grouped with the others whose source lies in the same
+// vertex range.
+struct TextArc {
+    int source;
+    int target;
+    int weight;
+};
+
+// Builds the CSR graph of the parsed edges; every vertex must lie in [1, n]. Vertices
+// are split into one range per worker. Each chunk first sorts its arcs by source range
+// with a stable counting sort (in parallel over the chunks, releasing the parsed edges
+// as it goes); each worker then counts and places the arcs of its range, taking the
+// chunks in order. Every arc is touched a constant number of times, no two workers
+// write the same memory and the arcs of each vertex keep the order of the file.
+inline CsrGraph buildTextCsrGraph(int n, bool isDirected, vector<TextEdgeChunk> chunks, ThreadPool& pool) {
+    CsrGraph csr;
+    csr.vertexCount = n;
+    csr.isDirected = isDirected;
+    csr.offsets.assign(n + 2, 0);
+    csr.minWeight = INT_MAX;
+    csr.maxWeight = INT_MIN;
+    for (const TextEdgeChunk& chunk : chunks) {
+        csr.minWeight = min(csr.minWeight, chunk.minWeight);
+        csr.maxWeight = max(csr.maxWeight, chunk.maxWeight);
+    }
+    if (csr.minWeight > csr.maxWeight) {
+        csr.minWeight = csr.maxWeight = 0;
+    }
+
+    int rangeWidth = max(1, (n + pool.size() - 1) / pool.size());
+    int ranges = max(1, (n + rangeWidth - 1) / rangeWidth);
+    int chunkCount = static_cast<int>(chunks.size());
+    // The arcs of chunk c with source range r are arcs[c][rangeBegin[c][r] ..
+    // rangeBegin[c][r + 1]).
+    vector<vector<TextArc>> arcs(chunkCount);
+    vector<vector<size_t>> rangeBegin(chunkCount, vector<size_t>(ranges + 1, 0));
+    pool.parallelFor(chunkCount, [&](int c, int) {
+        TextEdgeChunk& chunk = chunks[c];
+        vector<size_t>& begin = rangeBegin[c];
+        size_t edges = chunk.sources.size();
+        for (size_t i = 0; i < edges; i++) {
+            begin[(chunk.sources[i] - 1) / rangeWidth + 1]++;
+            if (!isDirected) {
+                begin[(chunk.targets[i] - 1) / rangeWidth + 1]++;
+            }
+        }
+        for (int r = 0; r < ranges; r++) {
+            begin[r + 1] += begin[r];
+        }
+        vector<size_t> next(begin.begin(), begin.end() - 1);
+        arcs[c].resize(begin[ranges]);
+        for (size_t i = 0; i < edges; i++) {
+            int u = chunk.sources[i];
+            int v = chunk.targets[i];
+            int w = chunk.weights[i];
+            arcs[c][next[(u - 1) / rangeWidth]++] = {u, v, w};
+            if (!isDirected) {
+                arcs[c][next[(v - 1) / rangeWidth]++] = {v, u, w};
+            }
+        }
+        chunk = TextEdgeChunk();
+    });
+
+    int* offsets = csr.offsets.data();
+    pool.parallelFor(ranges, [&](int r, int) {
+        for (int c = 0; c < chunkCount; c++) {
+            for (size_t i = rangeBegin[c][r]; i < rangeBegin[c][r + 1]; i++) {
+                offsets[arcs[c][i].source + 1]++;
+            }
+        }
+    });
+    for (int u = 1; u <= n + 1; u++) {
+        offsets[u] += offsets[u - 1];
+    }
+
+    csr.targets.resize(offsets[n + 1]);
+    csr.weights.resize(offsets[n + 1]);
+    int* targets = csr.targets.data();
+    int* weights = csr.weights.data();
+    vector<int> next(offsets, offsets + n + 1);
+    pool.parallelFor(ranges, [&](int r, int) {
+        for (int c = 0; c < chunkCount; c++) {
+            for (size_t i = rangeBegin[c][r]; i < rangeBegin[c][r + 1]; i++) {
+                const TextArc& arc = arcs[c][i];
+                int a = next[arc.source]++;
+                targets[a] = arc.target;
+                weights[a] = arc.weight;
+            }
+        }
+    });
+    return csr;
+}
+
+// Reads a DIMACS shortest-path or max-flow file ("p sp n m" / "p max n m" followed by
+// "a u v w" lines) as a directed graph with 1-based vertices.
+inline CsrGraph readDimacs(const string& path, ThreadPool& pool) {
+    MappedFile file(path);
+    file.adviseSequential();
+    vector<TextEdgeChunk> chunks = parseTextChunks(file, pool,
+        [](const char* begin, const char* end, TextEdgeChunk& chunk) {
+            return parseDimacsLine(begin, end, chunk);
+        });
+    checkTextChunks(chunks, file, path);
+
+    long long n = -1;
+    long long firstVertex = LLONG_MAX, lastVertex = LLONG_MIN;
+    long long arcs = 0;
+    for (const TextEdgeChunk& chunk : chunks) {
+        n = max(n, chunk.problemVertices);
+        firstVertex = min(firstVertex, chunk.firstVertex);
+        lastVertex = max(lastVertex, chunk.lastVertex);
+        arcs += chunk.sources.size();
+    }
+    if (n < 0) {
+        throw runtime_error("Missing problem line in " + path + "!");
+    }
+    if (n > INT_MAX - 2 || arcs > INT_MAX) {
+        throw runtime_error("Graph in " + path + " is too large!");
+    }
+    if (arcs > 0 && (firstVertex < 1 || lastVertex > n)) {
+        throw runtime_error("Vertex out of range in " + path + "!");
+    }
+    return buildTextCsrGraph(static_cast<int>(n), true, move(chunks), pool);
+}
+
+// Reads a text file with one edge "u v [w]" per line. Vertex ids start at firstId
+// (0 for most edge-list collections) and are shifted to start at 1; the vertex count
+// is the largest id found.
+inline CsrGraph readEdgeList(const string& path, bool isDirected, ThreadPool& pool, int firstId = 0) {
+    MappedFile file(path);
+    file.adviseSequential();
+    vector<TextEdgeChunk> chunks = parseTextChunks(file, pool,
+        [firstId](const char* begin, const char* end, TextEdgeChunk& chunk) {
+            return parseEdgeListLine(begin, end, firstId, chunk);
+        });
+    checkTextChunks(chunks, file, path);
+
+    long long firstVertex = LLONG_MAX, lastVertex = 0;
+    long long arcs = 0;
+    for (const TextEdgeChunk& chunk : chunks) {
+        firstVertex = min(firstVertex, chunk.firstVertex);
+        lastVertex = max(lastVertex, chunk.lastVertex);
+        arcs += chunk.sources.size() * (isDirected ? 1 : 2);
+    }
+    if (arcs > 0 && firstVertex < 1) {
+        throw runtime_error("Vertex id below " + to_string(firstId) + " in " + path + "!");
+    }
+    if (lastVertex > INT_MAX - 2 || arcs > INT_MAX) {
+        throw runtime_error("Graph in " + path + " is too large!");
+    }
+    return buildTextCsrGraph(static_cast<int>(lastVertex), isDirected, move(chunks), pool);
+}
+
+// Appends the decimal form of value to buffer.
+inline void appendInteger(string& buffer, long long value) {
+    char digits[24];
+    int length = 0;
+    unsigned long long magnitude = value < 0 ? 0ULL - value : value;
+    do {
+        digits[length++] = static_cast<char>('0' + magnitude % 10);
+        magnitude /= 10;
+    } while (magnitude > 0);
+    if (value < 0) {
+        buffer += '-';
+    }
+    while (length > 0) {
+        buffer += digits[--length];
+    }
+}
+
+// Writes the graph as a DIMACS shortest-path file with one "a" line per arc, so an
+// undirected graph is written with both directions of each edge.
+inline void writeDimacs(const CsrGraph& graph, const string& path) {
+    ofstream out(path, ios::binary);
+    if (!out) {
+        throw runtime_error("Cannot open " + path + " for writing!");
+    }
+    string buffer = "p sp " + to_string(graph.vertexCount) + " " + to_string(graph.arcCount()) + "\n";
+    for (int u = 1; u <= graph.vertexCount; u++) {
+        for (int a = graph.offsets[u]; a < graph.offsets[u + 1]; a++) {
+            buffer += "a ";
+            appendInteger(buffer, u);
+            buffer += ' ';
+            appendInteger(buffer, graph.targets[a]);
+            buffer += ' ';
+            appendInteger(buffer, graph.weights[a]);
+            buffer += '\n';
+        }
+        if (buffer.size() >= TEXT_CHUNK_BYTES) {
+            out.write(buffer.data(), buffer.size());
+            buffer.clear();
+        }
+    }
+    out.write(buffer.data(), buffer.size());
+    if (!out) {
+        throw runtime_error("Failed to write " + path + "!");
+    }
+}
+
+// Writes the graph as an edge list "u v w" with 0-based ids (readEdgeList()'s
+// default). An undirected edge is written once, from its smaller endpoint.
+inline void writeEdgeList(const CsrGraph& graph, const string& path) {
+    ofstream out(path, ios::binary);
+    if (!out) {
+        throw runtime_error("Cannot open " + path + " for writing!");
+    }
+    string buffer;
+    for (int u = 1; u <= graph.vertexCount; u++) {
+        bool skipLoop = false;  // an undirected self-loop is stored as two arcs
+        for (int a = graph.offsets[u]; a < graph.offsets[u + 1]; a++) {
+            int v = graph.targets[a];
+            if (!graph.isDirected && v <= u) {
+                skipLoop = v == u && !skipLoop;
+                if (!skipLoop) {
+                    continue;
+                }
+            }
+            appendInteger(buffer, u - 1);
+            buffer += ' ';
+            appendInteger(buffer, v - 1);
+            buffer += ' ';
+            appendInteger(buffer, graph.weights[a]);
+            buffer += '\n';
+        }
+        if (buffer.size() >= TEXT_CHUNK_BYTES) {
+            out.write(buffer.data(), buffer.size());
+            buffer.clear();
+        }
+    }
+    out.write(buffer.data(), buffer.size());
+    if (!out) {
+        throw runtime_error("Failed to write " + path + "!");
+    }
+}
+
+#endif // GRAPH_FILE_HPP
@@ -2,6 +2,7 @@
 #define GRAPH_GENERATOR_HPP
 
 #include <bits/stdc++.h>
+#include "ThreadPool.hpp"
 using namespace std;
 
 // -----------------------------------------------------------------------------
@@ -13,14 +14,18 @@ using namespace std;
 //    weak, semi, or strong connectivity.
 // 5. The minimum and maximum edge weights (0,0 indicates no weights).
 // 6. The minimum and maximum number of edges.
+// 7. The random seed (0 seeds from the clock, so every run differs).
+// 8. The graph model (see GraphModel).
 // -----------------------------------------------------------------------------
 
-// Structure describing the graph
-struct Graph {
-    int vertexCount;                     // Number of vertices
-    int edgeCount;                       // Number of edges
+// Structure describing the graph. W is the weight type (see WeightTraits.hpp); the
+// generator and most algorithms use Graph, i.e. int weights.
+template <class W>
+struct BasicGraph {
+    int vertexCount;                   // Number of vertices
+    int edgeCount;                     // Number of edges
     bool isDirected;
-    vector<tuple<int, int, int>> edges;  // Edges in the format (from, to, weight)
+    vector<tuple<int, int, W>> edges;  // Edges in the format (from, to, weight)
 
     void print(bool weighted) const {
         cout << "Number of vertices: " << vertexCount << "\n";
@@ -28,7 +33,7 @@ struct Graph {
         for (const auto& edge : edges) {
             int u = get<0>(edge);
             int v = get<1>(edge);
-            int w = get<2>(edge);
+            W w = get<2>(edge);
             if (weighted)
                 cout << u << " -> " << v << " [weight: " << w << "]\n";
             else
@@ -37,6 +42,22 @@ struct Graph {
     }
 };
 
+typedef BasicGraph<int> Graph;
+
+// Shape of the generated graph.
+// - Default:    random edges on top of the tree / connectivity structure requested
+//               by the flags of GraphInputs.
+// - ErdosRenyi: G(n, m), m distinct edges chosen uniformly; the tree and
+//               connectivity flags are ignored.
+// - RMat:       R-MAT (a stochastic Kronecker graph with a 2x2 initiator): every edge
+//               descends into one quadrant of the adjacency matrix per bit with
+//               probabilities 0.57, 0.19, 0.19, 0.05, giving skewed power-law degrees.
+//               Duplicates and self-loops are dropped and redrawn.
+// - Grid:       a 2-D grid of about sqrt(n) x sqrt(n) vertices with edges between
+//               horizontal and vertical neighbours (both directions when directed);
+//               the edge count range is ignored.
+enum class GraphModel { Default, ErdosRenyi, RMat, Grid };
+
 // Structure with input parameters for graph generation
 struct GraphInputs {
     int minVertexCount, maxVertexCount;
@@ -48,50 +69,110 @@ struct GraphInputs {
     bool isStronglyConnected;
     int minEdgeWeight, maxEdgeWeight;
     int minEdgeCount, maxEdgeCount;
+    unsigned long long seed;
+    GraphModel model;
+};
+
+// Counter-based random numbers: the i-th number of a stream is a SplitMix64 hash of
+// the seed, the stream id and i, so independent blocks of work draw from their own
+// streams on any thread and the result does not depend on the schedule.
+class CounterRng {
+public:
+    typedef unsigned long long result_type;
+
+    CounterRng(unsigned long long seed, unsigned long long stream)
+        : key_(mix(seed ^ mix(stream + 0x9E3779B97F4A7C15ULL))), counter_(0) {}
+
+    static constexpr result_type min() { return 0; }
+    static constexpr result_type max() { return ~0ULL; }
+
+    result_type operator()() {
+        return mix(key_ + 0x9E3779B97F4A7C15ULL * ++counter_);
+    }
+
+    // Returns a random integer in the range [low, high]
+    int uniform(int low, int high) {
+        unsigned long long range = static_cast<unsigned long long>(static_cast<long long>(high) - low + 1);
+        return static_cast<int>(low + static_cast<long long>((static_cast<unsigned __int128>((*this)()) * range) >> 64));
+    }
+
+    // Returns a random double in [0, 1)
+    double real() {
+        return ((*this)() >> 11) * (1.0 / 9007199254740992.0);
+    }
+
+private:
+    unsigned long long key_;
+    unsigned long long counter_;
+
+    static unsigned long long mix(unsigned long long x) {
+        x = (x ^ (x >> 30)) * 0xBF58476D1CE4E5B9ULL;
+        x = (x ^ (x >> 27)) * 0x94D049BB133111EBULL;
+        return x ^ (x >> 31);
+    }
 };
 
 // -----------------------------------------------------------------------------
 // GraphGenerator class that encapsulates the graph generation logic.
+// All randomness comes from CounterRng streams derived from the seed: the sizes and
+// the connectivity structure use one stream each, and the bulk of the edges is
+// produced in fixed blocks (of rows, candidate edges or grid rows) with one stream per
+// block. generate(pool) runs the blocks in parallel and returns exactly the graph
+// that generate() builds on one thread for the same seed.
 // -----------------------------------------------------------------------------
 class GraphGenerator {
 public:
     explicit GraphGenerator(const GraphInputs& inputs)
         : inputs_(inputs),
-          gen_(chrono::system_clock::now().time_since_epoch().count())
+          seed_(inputs.seed != 0 ? inputs.seed : chrono::system_clock::now().time_since_epoch().count())
     {
+        CounterRng rng = stream(STREAM_SIZES, 0);
         // Initialize the number of vertices and edges
-        vertexCount_ = randomInt(inputs_.minVertexCount, inputs_.maxVertexCount);
-        if (inputs_.isTree)
+        vertexCount_ = rng.uniform(inputs_.minVertexCount, inputs_.maxVertexCount);
+        if (inputs_.isTree && inputs_.model == GraphModel::Default)
             edgeCount_ = vertexCount_ - 1;
         else
-            edgeCount_ = randomInt(inputs_.minEdgeCount, inputs_.maxEdgeCount);
+            edgeCount_ = rng.uniform(inputs_.minEdgeCount, inputs_.maxEdgeCount);
 
         minWeight_ = inputs_.minEdgeWeight;
         maxWeight_ = inputs_.maxEdgeWeight;
         isDirected_ = inputs_.isDirected;
     }
 
+    // Seed the graph is generated from (chosen from the clock when inputs.seed is 0).
+    unsigned long long seed() const {
+        return seed_;
+    }
+
     // Generates a graph based on the input parameters
     Graph generate() {
-        int maxPossibleEdges = inputs_.isDirected ?
-            vertexCount_ * (vertexCount_ - 1) : (vertexCount_ * (vertexCount_ - 1)) / 2;
-        if (edgeCount_ > maxPossibleEdges) {
-            throw runtime_error("Too many edges requested!");
-        }
-
-        // Build the basic connectivity structure (tree or connected graph)
-        if (inputs_.isTree || inputs_.isConnected) {
-            buildBasicConnectivity();
-        }
-
-        // Add additional edges until the required number is reached
-        addRemainingEdges();
+        pool_ = nullptr;
+        return generateGraph();
+    }
 
-        return Graph{vertexCount_, edgeCount_, isDirected_, edges_};
+    // Same graph as generate(), with the edge blocks spread over the pool.
+    Graph generate(ThreadPool& pool) {
+        pool_ = &pool;
+        return generateGraph();
     }
 
 private:
+    static const int ROW_BLOCK = 256;         // rows per block of remaining edges
+    static const int RMAT_BLOCK = 1 << 16;    // candidate edges per R-MAT block
+    static const int MAX_RMAT_ROUNDS = 64;
+    // Cumulative R-MAT quadrant probabilities 0.57, 0.19, 0.19 in units of 1/65536.
+    static const unsigned RMAT_A = 57 * 65536 / 100;
+    static const unsigned RMAT_AB = 76 * 65536 / 100;
+    static const unsigned RMAT_ABC = 95 * 65536 / 100;
+
+    // Stream kinds; a block's stream id combines the kind with the block index.
+    enum StreamKind {
+        STREAM_SIZES = 1, STREAM_SHUFFLE, STREAM_TREE, STREAM_QUOTA, STREAM_ROW_BLOCK,
+        STREAM_RMAT, STREAM_RMAT_WEIGHTS, STREAM_GRID
+    };
+
     GraphInputs inputs_;
+    unsigned long long seed_;
     int vertexCount_;
     int edgeCount_;
     bool isDirected_;
@@ -99,21 +180,63 @@ private:
     int maxWeight_;
 
     vector<tuple<int, int, int>> edges_;
-    set<pair<int, int>> edgeSet_; // To ensure edge uniqueness
+    ThreadPool* pool_ = nullptr;
 
-    mt19937 gen_;
+    CounterRng stream(int kind, unsigned long long index) const {
+        return CounterRng(seed_, (static_cast<unsigned long long>(kind) << 48) | index);
+    }
 
-    // Returns a random integer in the range [low, high]
-    int randomInt(int low, int high) {
-        uniform_int_distribution<int> dis(low, high);
-        return dis(gen_);
+    int workerCount() const {
+        return pool_ ? pool_->size() : 1;
+    }
+
+    // Calls body(task, worker) for every task, on the pool if there is one.
+    void forEachBlock(int taskCount, const function<void(int, int)>& body) {
+        if (pool_) {
+            pool_->parallelFor(taskCount, body);
+        } else {
+            for (int task = 0; task < taskCount; task++)
+                body(task, 0);
+        }
+    }
+
+    Graph generateGraph() {
+        edges_.clear();
+        if (inputs_.model == GraphModel::Grid) {
+            makeGrid();
+            edgeCount_ = static_cast<int>(edges_.size());
+            return Graph{vertexCount_, edgeCount_, isDirected_, move(edges_)};
+        }
+
+        long long maxPossibleEdges = inputs_.isDirected ?
+            1LL * vertexCount_ * (vertexCount_ - 1) : 1LL * vertexCount_ * (vertexCount_ - 1) / 2;
+        if (edgeCount_ > maxPossibleEdges) {
+            throw runtime_error("Too many edges requested!");
+        }
+
+        if (inputs_.model == GraphModel::RMat) {
+            makeRMat();
+            return Graph{vertexCount_, edgeCount_, isDirected_, move(edges_)};
+        }
+
+        // Build the basic connectivity structure (tree or connected graph)
+        if (inputs_.model == GraphModel::Default && (inputs_.isTree || inputs_.isConnected)) {
+            buildBasicConnectivity();
+        }
+
+        // Add additional edges until the required number is reached
+        addRemainingEdges();
+
+        return Graph{vertexCount_, edgeCount_, isDirected_, move(edges_)};
     }
 
     // Returns a vector of numbers from 1 to count, randomly shuffled
     vector<int> generateShuffledVertices(int count) {
         vector<int> vertices(count);
         iota(vertices.begin(), vertices.end(), 1);
-        shuffle(vertices.begin(), vertices.end(), gen_);
+        CounterRng rng = stream(STREAM_SHUFFLE, 0);
+        for (int i = count - 1; i > 0; i--)
+            swap(vertices[i], vertices[rng.uniform(0, i)]);
         return vertices;
     }
 
@@ -122,16 +245,15 @@ private:
     // Creates weak connectivity by generating a spanning tree with arbitrary edge directions.
     void makeWeakConnectivity() {
         vector<int> vertices = generateShuffledVertices(vertexCount_);
+        CounterRng rng = stream(STREAM_TREE, 0);
         // For each vertex, starting from the second, select a random connection from the already processed vertices.
         for (int i = 2; i <= vertexCount_; i++) {
-            int u = vertices[randomInt(0, i - 2)];
-            int weight = randomInt(minWeight_, maxWeight_);
-            if (randomInt(0, 1) == 0) {
+            int u = vertices[rng.uniform(0, i - 2)];
+            int weight = rng.uniform(minWeight_, maxWeight_);
+            if (rng.uniform(0, 1) == 0) {
                 edges_.emplace_back(u, vertices[i - 1], weight);
-                edgeSet_.insert({u, vertices[i - 1]});
             } else {
                 edges_.emplace_back(vertices[i - 1], u, weight);
-                edgeSet_.insert({vertices[i - 1], u});
             }
         }
     }
@@ -139,47 +261,44 @@ private:
     // Creates a semi-connected graph by generating a Hamiltonian path.
     void makeSemiConnectivity() {
         vector<int> vertices = generateShuffledVertices(vertexCount_);
+        CounterRng rng = stream(STREAM_TREE, 0);
         // Generate a Hamiltonian path by connecting consecutive vertices.
         for (int i = 1; i < vertexCount_; i++) {
-            int weight = randomInt(minWeight_, maxWeight_);
+            int weight = rng.uniform(minWeight_, maxWeight_);
             edges_.emplace_back(vertices[i - 1], vertices[i], weight);
-            edgeSet_.insert({vertices[i - 1], vertices[i]});
         }
     }
 
     // Creates a strongly connected graph: a Hamiltonian path plus an edge that closes the cycle.
     void makeStrongConnectivity() {
         vector<int> vertices = generateShuffledVertices(vertexCount_);
+        CounterRng rng = stream(STREAM_TREE, 0);
         // Generate a Hamiltonian path
         for (int i = 1; i < vertexCount_; i++) {
-            int weight = randomInt(minWeight_, maxWeight_);
+            int weight = rng.uniform(minWeight_, maxWeight_);
             edges_.emplace_back(vertices[i - 1], vertices[i], weight);
-            edgeSet_.insert({vertices[i - 1], vertices[i]});
         }
         // Add an edge to close the cycle (last vertex -> first vertex)
-        int weight = randomInt(minWeight_, maxWeight_);
+        int weight = rng.uniform(minWeight_, maxWeight_);
         edges_.emplace_back(vertices[vertexCount_ - 1], vertices[0], weight);
-        edgeSet_.insert({vertices[vertexCount_ - 1], vertices[0]});
     }
 
     // Builds the basic connectivity structure of the graph.
     void buildBasicConnectivity() {
+        CounterRng rng = stream(STREAM_TREE, 0);
         if (!inputs_.isDirected) {
             // For undirected graphs: build a spanning tree.
             for (int i = 2; i <= vertexCount_; i++) {
-                int u = randomInt(1, i - 1);
-                int weight = randomInt(minWeight_, maxWeight_);
+                int u = rng.uniform(1, i - 1);
+                int weight = rng.uniform(minWeight_, maxWeight_);
                 edges_.emplace_back(u, i, weight);
-                edgeSet_.insert({u, i});
-                edgeSet_.insert({i, u});
             }
         } else if (inputs_.isTree) {
             // For a directed tree.
             for (int i = 2; i <= vertexCount_; i++) {
-                int u = randomInt(1, i - 1);
-                int weight = randomInt(minWeight_, maxWeight_);
+                int u = rng.uniform(1, i - 1);
+                int weight = rng.uniform(minWeight_, maxWeight_);
                 edges_.emplace_back(u, i, weight);
-                edgeSet_.insert({u, i});
             }
         } else if (inputs_.isStronglyConnected) {
             makeStrongConnectivity();
@@ -191,19 +310,279 @@ private:
     }
 
     // Adds random edges until the total number of edges reaches the required count.
+    // Candidate edges are grouped by row: the edges leaving u for directed graphs and
+    // the edges (u, v) with u < v for undirected ones. The missing edges are split
+    // binomially over blocks of ROW_BLOCK rows in proportion to their free slots, and
+    // each block splits its share over its rows the same way and picks them among the
+    // free targets, so no global set of edges is needed and the whole pass is
+    // O(V + E) at any density. Every block knows its output range in advance and
+    // draws from its own stream.
     void addRemainingEdges() {
-        while (static_cast<int>(edges_.size()) < edgeCount_) {
-            int u = randomInt(1, vertexCount_);
-            int v = randomInt(1, vertexCount_);
-            if (u == v || edgeSet_.count({u, v}))
+        int n = vertexCount_;
+        long long needed = edgeCount_ - static_cast<long long>(edges_.size());
+        if (needed <= 0)
+            return;
+
+        // The connectivity edges already present, bucketed by row.
+        vector<int> fixedOffsets(n + 2, 0);
+        for (const auto& edge : edges_)
+            fixedOffsets[rowOf(edge) + 1]++;
+        for (int u = 1; u <= n + 1; u++)
+            fixedOffsets[u] += fixedOffsets[u - 1];
+        vector<int> fixedTargets(edges_.size());
+        vector<int> next(fixedOffsets.begin(), fixedOffsets.end() - 1);
+        for (const auto& edge : edges_) {
+            int u = rowOf(edge);
+            fixedTargets[next[u]++] = get<0>(edge) + get<1>(edge) - u;
+        }
+
+        int blocks = (n + ROW_BLOCK - 1) / ROW_BLOCK;
+        vector<long long> blockSlots(blocks, 0);
+        long long available = 0;
+        for (int u = 1; u <= n; u++) {
+            long long slots = freeSlots(u, fixedOffsets);
+            blockSlots[(u - 1) / ROW_BLOCK] += slots;
+            available += slots;
+        }
+        vector<long long> blockStart(blocks + 1, static_cast<long long>(edges_.size()));
+        CounterRng quota = stream(STREAM_QUOTA, 0);
+        for (int b = 0; b < blocks; b++) {
+            long long count = split(needed, blockSlots[b], available, quota);
+            blockStart[b + 1] = blockStart[b] + count;
+        }
+        edges_.resize(blockStart[blocks]);
+
+        vector<vector<char>> taken(workerCount(), vector<char>(n + 1, 0));
+        vector<vector<int>> picked(workerCount());
+        forEachBlock(blocks, [&](int b, int worker) {
+            CounterRng rng = stream(STREAM_ROW_BLOCK, b);
+            long long blockNeeded = blockStart[b + 1] - blockStart[b];
+            long long blockAvailable = blockSlots[b];
+            long long out = blockStart[b];
+            int last = min(n, (b + 1) * ROW_BLOCK);
+            for (int u = b * ROW_BLOCK + 1; u <= last && blockNeeded > 0; u++) {
+                long long slots = freeSlots(u, fixedOffsets);
+                long long count = split(blockNeeded, slots, blockAvailable, rng);
+                for (int a = fixedOffsets[u]; a < fixedOffsets[u + 1]; a++)
+                    taken[worker][fixedTargets[a]] = 1;
+                fillRow(u, static_cast<int>(count), static_cast<int>(slots), taken[worker], picked[worker], rng, out);
+                for (int a = fixedOffsets[u]; a < fixedOffsets[u + 1]; a++)
+                    taken[worker][fixedTargets[a]] = 0;
+            }
+        });
+    }
+
+    // Draws how many of the `needed` items go to a part with `slots` of the
+    // `available` free places (binomially, clamped so that the rest still fit), and
+    // takes both out of the totals.
+    static long long split(long long& needed, long long slots, long long& available, CounterRng& rng) {
+        long long count = needed;
+        if (slots < available) {
+            long long drawn = binomial(needed, static_cast<double>(slots) / available, rng);
+            count = max(needed - (available - slots), min(min(slots, needed), drawn));
+        }
+        available -= slots;
+        needed -= count;
+        return count;
+    }
+
+    // Binomial(trials, p) sample: by inversion for small means, otherwise from the
+    // normal approximation. std::binomial_distribution is not used because it calls
+    // lgamma(), which writes the global signgam and so races between blocks.
+    static long long binomial(long long trials, double p, CounterRng& rng) {
+        double mean = trials * p;
+        if (mean < 16) {
+            double u = rng.real();
+            double term = exp(trials * log1p(-p));
+            double cdf = term;
+            long long k = 0;
+            while (u > cdf && k < trials) {
+                term *= (trials - k) / (k + 1.0) * p / (1 - p);
+                cdf += term;
+                k++;
+            }
+            return k;
+        }
+        double gaussian = sqrt(-2 * log(1 - rng.real())) * cos(2 * M_PI * rng.real());
+        long long k = llround(mean + sqrt(mean * (1 - p)) * gaussian);
+        return max(0LL, min(trials, k));
+    }
+
+    // Row of an edge: its source, or its smaller endpoint for undirected graphs.
+    int rowOf(const tuple<int, int, int>& edge) const {
+        return isDirected_ ? get<0>(edge) : min(get<0>(edge), get<1>(edge));
+    }
+
+    // Number of candidate targets in row u that no connectivity edge uses yet.
+    long long freeSlots(int u, const vector<int>& fixedOffsets) const {
+        int size = isDirected_ ? vertexCount_ - 1 : vertexCount_ - u;
+        return size - (fixedOffsets[u + 1] - fixedOffsets[u]);
+    }
+
+    // Writes count edges from row u towards targets not marked in taken, out of slots
+    // free ones, to edges_[out...]. Sparse rows pick targets at random and retry
+    // marked ones; rows that are more than half full pick the targets to leave out
+    // instead and take the rest. Marks set here are cleared again before returning.
+    void fillRow(int u, int count, int slots, vector<char>& taken, vector<int>& picked,
+                 CounterRng& rng, long long& out) {
+        int low = isDirected_ ? 1 : u + 1;
+        int high = vertexCount_;
+        bool complement = count > slots / 2;
+        int picks = complement ? slots - count : count;
+        picked.clear();
+        taken[u] = 1;
+        while (static_cast<int>(picked.size()) < picks) {
+            int v = rng.uniform(low, high);
+            if (taken[v])
                 continue;
+            taken[v] = 1;
+            picked.push_back(v);
+            if (!complement)
+                edges_[out++] = makeEdge(u, v, rng);
+        }
+        if (complement) {
+            for (int v = low; v <= high; v++) {
+                if (!taken[v])
+                    edges_[out++] = makeEdge(u, v, rng);
+            }
+        }
+        taken[u] = 0;
+        for (int v : picked)
+            taken[v] = 0;
+    }
+
+    // Undirected edges get a random orientation, like the rest of the generator.
+    tuple<int, int, int> makeEdge(int u, int v, CounterRng& rng) const {
+        int weight = rng.uniform(minWeight_, maxWeight_);
+        if (!isDirected_ && (rng() & 1))
+            swap(u, v);
+        return make_tuple(u, v, weight);
+    }
 
-            int weight = randomInt(minWeight_, maxWeight_);
-            edges_.emplace_back(u, v, weight);
-            edgeSet_.insert({u, v});
-            if (!inputs_.isDirected)
-                edgeSet_.insert({v, u});
+    // R-MAT: candidate edges are drawn in blocks of RMAT_BLOCK with one stream per
+    // block and round, each level from 16 random bits. The candidates of a round are
+    // deduplicated by sorting each row's targets and merged into the edges so far, and
+    // the shortfall left by duplicates and self-loops is drawn again in the next round.
+    // The edges end up ordered by their smaller endpoint, then by the other one.
+    void makeRMat() {
+        int n = vertexCount_;
+        int scale = 0;
+        while ((1LL << scale) < n)
+            scale++;
+        vector<unsigned long long> keys;
+        for (int round = 0; static_cast<long long>(keys.size()) < edgeCount_; round++) {
+            if (round == MAX_RMAT_ROUNDS)
+                throw runtime_error("Too many edges requested!");
+            long long missing = edgeCount_ - static_cast<long long>(keys.size());
+            int blocks = static_cast<int>((missing + RMAT_BLOCK - 1) / RMAT_BLOCK);
+            vector<vector<unsigned long long>> drawn(blocks);
+            forEachBlock(blocks, [&](int b, int) {
+                CounterRng rng = stream(STREAM_RMAT, static_cast<unsigned long long>(round) << 32 | b);
+                long long count = min<long long>(RMAT_BLOCK, missing - 1LL * b * RMAT_BLOCK);
+                for (long long i = 0; i < count; i++) {
+                    long long u = 0, v = 0;
+                    unsigned long long bits = 0;
+                    for (int bit = 0; bit < scale; bit++) {
+                        if (bit % 4 == 0)
+                            bits = rng();
+                        unsigned r = bits & 0xffff;
+                        bits >>= 16;
+                        int down = r >= RMAT_AB;   // quadrants c and d
+                        int right = (r >= RMAT_A) ^ down ^ (r >= RMAT_ABC);  // quadrants b and d
+                        u = u << 1 | down;
+                        v = v << 1 | right;
+                    }
+                    if (u >= n || v >= n || u == v)
+                        continue;
+                    if (!isDirected_ && u > v)
+                        swap(u, v);
+                    drawn[b].push_back(static_cast<unsigned long long>(u + 1) << 32 | (v + 1));
+                }
+            });
+            vector<unsigned long long> fresh;
+            for (const auto& block : drawn)
+                fresh.insert(fresh.end(), block.begin(), block.end());
+            sortUnique(fresh, n);
+            vector<unsigned long long> merged;
+            merged.reserve(keys.size() + fresh.size());
+            set_union(keys.begin(), keys.end(), fresh.begin(), fresh.end(), back_inserter(merged));
+            keys.swap(merged);
         }
+
+        edges_.resize(keys.size());
+        int blocks = static_cast<int>((keys.size() + RMAT_BLOCK - 1) / RMAT_BLOCK);
+        forEachBlock(blocks, [&](int b, int) {
+            CounterRng rng = stream(STREAM_RMAT_WEIGHTS, b);
+            size_t end = min(keys.size(), static_cast<size_t>(b + 1) * RMAT_BLOCK);
+            for (size_t i = static_cast<size_t>(b) * RMAT_BLOCK; i < end; i++)
+                edges_[i] = makeEdge(static_cast<int>(keys[i] >> 32), static_cast<int>(keys[i] & 0xffffffffULL), rng);
+        });
+    }
+
+    // Sorts keys (source << 32 | target) and removes duplicates: a counting sort by
+    // source, then a sort of each row's targets.
+    void sortUnique(vector<unsigned long long>& keys, int n) {
+        vector<long long> offsets(n + 2, 0);
+        for (unsigned long long key : keys)
+            offsets[(key >> 32) + 1]++;
+        for (int u = 1; u <= n + 1; u++)
+            offsets[u] += offsets[u - 1];
+        vector<unsigned long long> sorted(keys.size());
+        vector<long long> next(offsets.begin(), offsets.end() - 1);
+        for (unsigned long long key : keys)
+            sorted[next[key >> 32]++] = key;
+        vector<long long> kept(n + 1, 0);
+        int blocks = (n + ROW_BLOCK - 1) / ROW_BLOCK;
+        forEachBlock(blocks, [&](int b, int) {
+            int last = min(n, (b + 1) * ROW_BLOCK);
+            for (int u = b * ROW_BLOCK + 1; u <= last; u++) {
+                auto begin = sorted.begin() + offsets[u];
+                auto end = sorted.begin() + offsets[u + 1];
+                sort(begin, end);
+                kept[u] = unique(begin, end) - begin;
+            }
+        });
+        keys.clear();
+        for (int u = 1; u <= n; u++)
+            keys.insert(keys.end(), sorted.begin() + offsets[u], sorted.begin() + offsets[u] + kept[u]);
+    }
+
+    // 2-D grid: vertex (r, c) is r * columns + c + 1, and each grid row is one block.
+    void makeGrid() {
+        int n = vertexCount_;
+        int columns = max(1, static_cast<int>(ceil(sqrt(static_cast<double>(n)))));
+        int rows = (n + columns - 1) / columns;
+        int copies = isDirected_ ? 2 : 1;
+        // Edges to the right and downwards from every vertex of grid row r.
+        auto edgesOfRow = [&](int r) {
+            long long first = 1LL * r * columns + 1;
+            long long last = min<long long>(n, first + columns - 1);
+            long long right = last - first;
+            long long down = max(0LL, min<long long>(n, last + columns) - (first + columns) + 1);
+            return (right + down) * copies;
+        };
+        vector<long long> rowStart(rows + 1, 0);
+        for (int r = 0; r < rows; r++)
+            rowStart[r + 1] = rowStart[r] + edgesOfRow(r);
+        edges_.resize(rowStart[rows]);
+        forEachBlock(rows, [&](int r, int) {
+            CounterRng rng = stream(STREAM_GRID, r);
+            long long out = rowStart[r];
+            for (int c = 0; c < columns; c++) {
+                int u = r * columns + c + 1;
+                if (u > n)
+                    break;
+                int neighbours[2] = {c + 1 < columns ? u + 1 : 0, u + columns};
+                for (int v : neighbours) {
+                    if (v < 1 || v > n)
+                        continue;
+                    int weight = rng.uniform(minWeight_, maxWeight_);
+                    edges_[out++] = make_tuple(u, v, weight);
+                    if (isDirected_)
+                        edges_[out++] = make_tuple(v, u, weight);
+                }
+            }
+        });
     }
 };
 
@@ -2,59 +2,321 @@
 #define KRUSKAL_HPP
 
 #include <bits/stdc++.h>
+#include "GraphGenerator.hpp"
+#include "CsrGraph.hpp"
+#include "ThreadPool.hpp"
+#include "AlgorithmStats.hpp"
 
 class DisjointSet {
   public:
-    DisjointSet(int n): parent(n + 1) {
+    DisjointSet(int n): parent(n + 1), size(n + 1, 1) {
         for (int i = 0; i <= n; i++) {
             parent[i] = i;
         }
     }
 
+    // Iterative find with path halving: every visited element is linked to its
+    // grandparent, so no recursion is needed however deep the tree is.
     int find(int x) {
-        if (parent[x] != x) {
-            parent[x] = find(parent[x]);
+        while (parent[x] != x) {
+            parent[x] = parent[parent[x]];
+            x = parent[x];
         }
-        return parent[x];
+        return x;
     }
 
+    // Find without path halving. It does not modify the structure, so several threads
+    // may call it concurrently as long as no union runs at the same time.
+    int findRoot(int x) const {
+        while (parent[x] != x) {
+            x = parent[x];
+        }
+        return x;
+    }
+
+    // Union by size: the smaller tree is attached below the root of the larger one.
     bool unionSets(int a, int b) {
         a = find(a);
         b = find(b);
         if (a == b) {
             return false;
         }
+        if (size[a] < size[b]) {
+            swap(a, b);
+        }
         parent[b] = a;
+        size[a] += size[b];
         return true;
     }
   private:
     vector<int> parent;
+    vector<int> size;
 };
 
+// Edge ranges at most this large (or at most n edges) are sorted directly.
+const int KRUSKAL_SORT_THRESHOLD = 1024;
+// Edge ranges at least this large are partitioned, filtered and sorted in parallel.
+const int KRUSKAL_PARALLEL_THRESHOLD = 1 << 16;
 
+// -----------------------------------------------------------------------------
+// Filter-Kruskal (Osipov, Sanders and Singler). Instead of sorting every edge, the
+// edges are partitioned around a pivot edge: the lighter part is solved
+// recursively, copies of the pivot are added, and the heavier part is filtered,
+// dropping every edge whose endpoints are already connected, before the loop
+// continues on what is left. Small ranges fall back to sorting. The run stops as
+// soon as n - 1 edges have been chosen.
+// Edges are oriented and ordered by lighterEdge(), so the tree is returned in that
+// order and weight ties are broken like in prim() and boruvka().
+// With a ThreadPool, large partitions, filters and sorts run in parallel.
+// stats receives "partition", "filter" and "sort" phases and counts disjoint-set
+// finds and unions (see AlgorithmStats.hpp).
+// -----------------------------------------------------------------------------
+template <class Stats>
+class BasicFilterKruskal {
+  public:
+    BasicFilterKruskal(const Graph& graph, ThreadPool* pool, Stats& stats)
+        : n(graph.vertexCount), pool(pool), stats(stats), ds(graph.vertexCount), totalWeight(0) {
+        if (graph.isDirected) {
+            throw runtime_error("Kruskal only for undirected!");
+        }
+        edges.reserve(graph.edges.size());
+        for (const auto& edge : graph.edges) {
+            edges.push_back(orientedEdge(get<0>(edge), get<1>(edge), get<2>(edge)));
+        }
+    }
 
-pair<int, vector<tuple<int, int, int>>> kruskal(const Graph& graph) {
-    if (graph.isDirected) {
-        throw runtime_error("Kruskal only for undirected!");
+    pair<long long, vector<tuple<int, int, int>>> run() {
+        if (pool != nullptr) {
+            buffer.resize(edges.size());
+        }
+        stats.beginPhase("kruskal");
+        solve(0, static_cast<int>(edges.size()));
+        stats.endPhase();
+        return {totalWeight, move(result)};
     }
-    int n = graph.vertexCount;
-    auto edges = graph.edges;
-    sort(edges.begin(), edges.end(), [](const tuple<int, int, int>& a,
-                                        const tuple<int, int, int>& b){
-        return get<2>(a) < get<2>(b);
-         });
-    DisjointSet ds(n);
-    int totalWeight = 0;
+
+  private:
+    int n;
+    vector<tuple<int, int, int>> edges;
+    ThreadPool* pool;
+    Stats& stats;
+    DisjointSet ds;
+    long long totalWeight;
     vector<tuple<int, int, int>> result;
-     for (const auto &edge : edges) {
-        int u, v, w;
-        tie(u, v, w) = edge;
-        if (ds.unionSets(u, v)) {
+    vector<tuple<int, int, int>> buffer;  // scratch space of the parallel steps
+
+    bool done() const {
+        return static_cast<int>(result.size()) >= n - 1;
+    }
+
+    bool parallel(int begin, int end) const {
+        return pool != nullptr && pool->size() > 1 && end - begin >= KRUSKAL_PARALLEL_THRESHOLD;
+    }
+
+    void addEdge(const tuple<int, int, int>& edge) {
+        stats.count(StatCounter::DsuFinds, 2);
+        if (ds.unionSets(get<0>(edge), get<1>(edge))) {
+            stats.count(StatCounter::DsuUnions);
             result.push_back(edge);
-            totalWeight += w;
+            totalWeight += get<2>(edge);
+        }
+    }
+
+    void solve(int begin, int end) {
+        while (!done() && end - begin > max(KRUSKAL_SORT_THRESHOLD, n)) {
+            tuple<int, int, int> pivot = choosePivot(begin, end);
+            stats.beginPhase("partition");
+            pair<int, int> bounds = partition(begin, end, pivot);
+            stats.endPhase();
+            solve(begin, bounds.first);
+            for (int i = bounds.first; i < bounds.second && !done(); i++) {
+                addEdge(edges[i]);
+            }
+            if (done()) {
+                return;
+            }
+            begin = bounds.second;
+            stats.beginPhase("filter");
+            stats.count(StatCounter::DsuFinds, 2LL * (end - begin));
+            end = filter(begin, end);
+            stats.endPhase();
+        }
+        if (done() || begin >= end) {
+            return;
+        }
+        stats.beginPhase("sort");
+        sortEdges(begin, end);
+        stats.endPhase();
+        for (int i = begin; i < end && !done(); i++) {
+            addEdge(edges[i]);
+        }
+    }
+
+    // Median of the first, middle and last edge of the range.
+    tuple<int, int, int> choosePivot(int begin, int end) const {
+        tuple<int, int, int> a = edges[begin];
+        tuple<int, int, int> b = edges[begin + (end - begin) / 2];
+        tuple<int, int, int> c = edges[end - 1];
+        if (lighterEdge(b, a)) {
+            swap(a, b);
+        }
+        if (lighterEdge(c, b)) {
+            b = lighterEdge(c, a) ? a : c;
+        }
+        return b;
+    }
+
+    // Reorders [begin, end) into edges lighter than, equal to and heavier than pivot
+    // and returns the start of the second and third group.
+    pair<int, int> partition(int begin, int end, const tuple<int, int, int>& pivot) {
+        if (parallel(begin, end)) {
+            return parallelPartition(begin, end, pivot);
         }
+        int lt = begin, i = begin, gt = end;
+        while (i < gt) {
+            if (lighterEdge(edges[i], pivot)) {
+                swap(edges[lt++], edges[i++]);
+            } else if (lighterEdge(pivot, edges[i])) {
+                swap(edges[i], edges[--gt]);
+            } else {
+                i++;
+            }
+        }
+        return {lt, gt};
+    }
+
+    // Drops the edges of [begin, end) whose endpoints are already connected and
+    // returns the new end of the range.
+    int filter(int begin, int end) {
+        if (parallel(begin, end)) {
+            return parallelFilter(begin, end);
+        }
+        int kept = begin;
+        for (int i = begin; i < end; i++) {
+            if (ds.find(get<0>(edges[i])) != ds.find(get<1>(edges[i]))) {
+                edges[kept++] = edges[i];
+            }
+        }
+        return kept;
+    }
+
+    void sortEdges(int begin, int end) {
+        if (!parallel(begin, end)) {
+            sort(edges.begin() + begin, edges.begin() + end, lighterEdge);
+            return;
+        }
+        // Sort one chunk per worker, then merge neighbouring runs pairwise.
+        int chunks = pool->size();
+        vector<int> bounds(chunks + 1);
+        for (int c = 0; c <= chunks; c++) {
+            bounds[c] = begin + (int)((long long)(end - begin) * c / chunks);
+        }
+        pool->parallelFor(chunks, [&](int c, int) {
+            sort(edges.begin() + bounds[c], edges.begin() + bounds[c + 1], lighterEdge);
+        });
+        for (int width = 1; width < chunks; width *= 2) {
+            int merges = (chunks + 2 * width - 1) / (2 * width);
+            pool->parallelFor(merges, [&](int m, int) {
+                int first = 2 * m * width;
+                int middle = min(chunks, first + width);
+                int last = min(chunks, first + 2 * width);
+                inplace_merge(edges.begin() + bounds[first], edges.begin() + bounds[middle],
+                              edges.begin() + bounds[last], lighterEdge);
+            });
+        }
+    }
+
+    // Splits [begin, end) into one chunk per worker. Each step counts per chunk, turns
+    // the counts into output offsets and scatters into buffer, keeping chunk order.
+    vector<int> chunkBounds(int begin, int end) const {
+        int chunks = pool->size() * 4;
+        vector<int> bounds(chunks + 1);
+        for (int c = 0; c <= chunks; c++) {
+            bounds[c] = begin + (int)((long long)(end - begin) * c / chunks);
+        }
+        return bounds;
+    }
+
+    pair<int, int> parallelPartition(int begin, int end, const tuple<int, int, int>& pivot) {
+        vector<int> bounds = chunkBounds(begin, end);
+        int chunks = static_cast<int>(bounds.size()) - 1;
+        vector<array<int, 3>> counts(chunks, array<int, 3>{{0, 0, 0}});
+        auto group = [&pivot](const tuple<int, int, int>& edge) {
+            return lighterEdge(edge, pivot) ? 0 : (lighterEdge(pivot, edge) ? 2 : 1);
+        };
+        pool->parallelFor(chunks, [&](int c, int) {
+            for (int i = bounds[c]; i < bounds[c + 1]; i++) {
+                counts[c][group(edges[i])]++;
+            }
+        });
+        vector<array<int, 3>> offsets(chunks);
+        int next = begin;
+        for (int g = 0; g < 3; g++) {
+            for (int c = 0; c < chunks; c++) {
+                offsets[c][g] = next;
+                next += counts[c][g];
+            }
+        }
+        pool->parallelFor(chunks, [&](int c, int) {
+            array<int, 3> out = offsets[c];
+            for (int i = bounds[c]; i < bounds[c + 1]; i++) {
+                buffer[out[group(edges[i])]++] = edges[i];
+            }
+        });
+        pool->parallelFor(chunks, [&](int c, int) {
+            copy(buffer.begin() + bounds[c], buffer.begin() + bounds[c + 1], edges.begin() + bounds[c]);
+        });
+        return {offsets[0][1], offsets[0][2]};
     }
-    return {totalWeight, result};
+
+    int parallelFilter(int begin, int end) {
+        vector<int> bounds = chunkBounds(begin, end);
+        int chunks = static_cast<int>(bounds.size()) - 1;
+        vector<int> counts(chunks, 0);
+        // Only findRoot() runs during the parallel phase, so the structure is read-only.
+        pool->parallelFor(chunks, [&](int c, int) {
+            int kept = bounds[c];
+            for (int i = bounds[c]; i < bounds[c + 1]; i++) {
+                if (ds.findRoot(get<0>(edges[i])) != ds.findRoot(get<1>(edges[i]))) {
+                    buffer[kept++] = edges[i];
+                }
+            }
+            counts[c] = kept - bounds[c];
+        });
+        vector<int> offsets(chunks);
+        int next = begin;
+        for (int c = 0; c < chunks; c++) {
+            offsets[c] = next;
+            next += counts[c];
+        }
+        pool->parallelFor(chunks, [&](int c, int) {
+            copy(buffer.begin() + bounds[c], buffer.begin() + bounds[c] + counts[c], edges.begin() + offsets[c]);
+        });
+        return next;
+    }
+};
+
+typedef BasicFilterKruskal<NullStats> FilterKruskal;
+
+template <bool Enabled>
+pair<long long, vector<tuple<int, int, int>>> kruskal(const Graph& graph, AlgorithmStats<Enabled>& stats) {
+    BasicFilterKruskal<AlgorithmStats<Enabled>> solver(graph, nullptr, stats);
+    return solver.run();
+}
+
+pair<long long, vector<tuple<int, int, int>>> kruskal(const Graph& graph) {
+    return kruskal(graph, nullStats());
+}
+
+// Same as kruskal(graph), with large partition, filter and sort steps run on pool.
+template <bool Enabled>
+pair<long long, vector<tuple<int, int, int>>> kruskal(const Graph& graph, ThreadPool& pool, AlgorithmStats<Enabled>& stats) {
+    BasicFilterKruskal<AlgorithmStats<Enabled>> solver(graph, &pool, stats);
+    return solver.run();
+}
+
+pair<long long, vector<tuple<int, int, int>>> kruskal(const Graph& graph, ThreadPool& pool) {
+    return kruskal(graph, pool, nullStats());
 }
 
 #endif // KRUSKAL_HPP
@@ -0,0 +1,342 @@
+#ifndef MIN_COST_FLOW_HPP
+#define MIN_COST_FLOW_HPP
+
+#include "GraphGenerator.hpp"
+#include "CsrGraph.hpp"
+#include "FlowEdge.hpp"
+#include "DinicAlgorithm.hpp"
+#include "BellmanFordAlgorithm.hpp"
+#include "PriorityQueues.hpp"
+#include <bits/stdc++.h>
+
+const long long COST_INF = numeric_limits<long long>::max();
+
+// Value added by a min-cost flow run and the total cost of the flow left in the
+// network.
+template <class Cap>
+struct MinCostFlowResult {
+    Cap flow;
+    long long cost;
+};
+
+// -----------------------------------------------------------------------------
+// Minimum-cost flow on a directed network built with edge costs (see
+// buildFlowNetwork(graph, costs)). Cap must be an integral type. Like Dinic, every
+// call starts from the flow already in the network.
+//
+// The default mode is successive shortest paths. Vertex potentials p keep the
+// reduced costs cost[a] + p[tail] - p[head] of all residual arcs non-negative, so
+// every augmenting path is found by a Dijkstra search (with a 64-bit RadixHeap) that
+// stops once the sink is settled. The potentials come from one bellmanFordQueue()
+// run over the residual arcs when some of them have negative cost, and are zero
+// otherwise. After each search the settled vertices take their distance into their
+// potential and the rest that of the sink, which keeps every reduced cost
+// non-negative; the flow stays of minimum cost for its value throughout.
+//
+// With costScaling, Dinic first pushes the flow and Goldberg's cost-scaling
+// push-relabel then turns it into one of minimum cost: costs are multiplied by n + 1,
+// and for epsilon = the largest cost divided by ALPHA each round down to 1, refine()
+// saturates every arc of negative reduced cost and pushes the resulting excess along
+// arcs of negative reduced cost, lowering prices as needed, until the flow is
+// epsilon-optimal. A 1/(n + 1)-optimal flow of integer costs is optimal. Prices are
+// also recomputed by a search from the deficits (priceUpdate()) at the start of each
+// refine and after every n relabels. This does far fewer searches than successive
+// shortest paths when the flow needs many paths.
+// -----------------------------------------------------------------------------
+template <class Cap>
+class BasicMinCostFlow {
+  public:
+    BasicMinCostFlow(BasicFlowNetwork<Cap>& network, bool costScaling = false)
+        : network(network), n(network.n), costScaling(costScaling), dinic(network) {
+        if (!network.isDirected) {
+            throw runtime_error("Min-cost flow only for directed!");
+        }
+        if (!network.hasCosts()) {
+            throw runtime_error("Network has no costs!");
+        }
+        potential.resize(n + 1);
+        dist.assign(n + 1, COST_INF);
+        parentArc.resize(n + 1);
+    }
+
+    // Sends up to limit additional units of flow from s to t (as much as possible by
+    // default) so that the whole flow in the network has minimum cost for its value.
+    MinCostFlowResult<Cap> minCostFlow(int s, int t, Cap limit = numeric_limits<Cap>::max()) {
+        if (s == t) {
+            throw runtime_error("Source and sink must differ!");
+        }
+        Cap flow = costScaling ? scaledFlow(s, t, limit) : shortestPathFlow(s, t, limit);
+        return {flow, network.flowCost()};
+    }
+
+  private:
+    static const int ALPHA = 16;  // epsilon shrinks by this factor per refine
+
+    BasicFlowNetwork<Cap>& network;
+    int n;
+    bool costScaling;
+    BasicDinic<Cap> dinic;
+    vector<long long> potential;  // potentials, or prices in the cost-scaling mode
+    vector<long long> dist;       // COST_INF except for the vertices in touched
+    vector<int> touched;
+    vector<int> parentArc;
+    RadixHeap<int, long long> heap;
+    vector<Cap> excess;
+    vector<int> current;          // current arc of each vertex
+    vector<int> active;           // FIFO of vertices with excess
+    int relabels;                 // relabels since the last price update
+
+    int tail(int a) const {
+        return network.head[network.rev[a]];
+    }
+
+    long long reducedCost(int a) const {
+        return network.cost[a] + potential[tail(a)] - potential[network.head[a]];
+    }
+
+    // Shortest residual distances from s by queue-based Bellman-Ford, as potentials.
+    // Costs and distances stay 64-bit: path costs beyond int range are common with
+    // large arc costs, and a distance that saturated would read as unreachable.
+    void initialPotentials(int s) {
+        fill(potential.begin(), potential.end(), 0);
+        bool negative = false;
+        for (int a = 0; a < network.arcCount(); a++) {
+            negative |= network.residual[a] > 0 && network.cost[a] < 0;
+        }
+        if (!negative) {
+            return;
+        }
+        BasicCsrGraph<long long> residualGraph;
+        residualGraph.vertexCount = n;
+        residualGraph.isDirected = true;
+        residualGraph.offsets.assign(n + 2, 0);
+        residualGraph.minWeight = 0;
+        residualGraph.maxWeight = 0;
+        for (int u = 1; u <= n; u++) {
+            for (int a = network.offsets[u]; a < network.offsets[u + 1]; a++) {
+                if (network.residual[a] > 0) {
+                    long long w = network.cost[a];
+                    residualGraph.targets.push_back(network.head[a]);
+                    residualGraph.weights.push_back(w);
+                    residualGraph.minWeight = min(residualGraph.minWeight, w);
+                    residualGraph.maxWeight = max(residualGraph.maxWeight, w);
+                }
+            }
+            residualGraph.offsets[u + 1] = residualGraph.arcCount();
+        }
+        residualGraph.offsets[n + 1] = residualGraph.arcCount();
+        BasicBellmanFordResult<long long> result = bellmanFordQueue(residualGraph, s);
+        if (result.hasNegativeCycle) {
+            throw runtime_error("Negative cost cycle!");
+        }
+        // Vertices unreachable from s never become reachable, so their potential
+        // does not matter.
+        for (int v = 1; v <= n; v++) {
+            if (result.dist[v] < WeightTraits<long long>::infinity()) {
+                potential[v] = result.dist[v];
+            }
+        }
+    }
+
+    // Dijkstra over reduced costs from s until t is settled. Returns false if t cannot
+    // be reached; otherwise parentArc holds a shortest path and the potentials are
+    // updated.
+    bool shortestPath(int s, int t) {
+        for (int v : touched) {
+            dist[v] = COST_INF;
+        }
+        touched.clear();
+        heap.clear();
+        dist[s] = 0;
+        touched.push_back(s);
+        heap.push(0, s);
+        while (!heap.empty()) {
+            auto top = heap.pop();
+            int u = top.second;
+            if (top.first != dist[u]) {
+                continue;
+            }
+            if (u == t) {
+                break;
+            }
+            for (int a = network.offsets[u]; a < network.offsets[u + 1]; a++) {
+                if (network.residual[a] <= 0) {
+                    continue;
+                }
+                int v = network.head[a];
+                long long d = top.first + reducedCost(a);
+                if (d < dist[v]) {
+                    if (dist[v] == COST_INF) {
+                        touched.push_back(v);
+                    }
+                    dist[v] = d;
+                    parentArc[v] = a;
+                    heap.push(d, v);
+                }
+            }
+        }
+        if (dist[t] == COST_INF) {
+            return false;
+        }
+        // p[v] += min(dist[v], dist[t]) for every vertex, shifted by -dist[t] so that
+        // untouched vertices keep their potential.
+        for (int v : touched) {
+            potential[v] += min(dist[v], dist[t]) - dist[t];
+        }
+        return true;
+    }
+
+    Cap shortestPathFlow(int s, int t, Cap limit) {
+        initialPotentials(s);
+        Cap total = 0;
+        while (total < limit && shortestPath(s, t)) {
+            Cap amount = limit - total;
+            for (int v = t; v != s; v = tail(parentArc[v])) {
+                amount = min(amount, network.residual[parentArc[v]]);
+            }
+            for (int v = t; v != s; v = tail(parentArc[v])) {
+                int a = parentArc[v];
+                network.residual[a] -= amount;
+                network.residual[network.rev[a]] += amount;
+            }
+            total += amount;
+        }
+        return total;
+    }
+
+    Cap scaledFlow(int s, int t, Cap limit) {
+        Cap total = dinic.pushFlow(s, t, limit);
+        vector<long long> originalCost = network.cost;
+        long long maxCost = 0;
+        for (long long& c : network.cost) {
+            c *= n + 1;
+            maxCost = max(maxCost, llabs(c));
+        }
+        fill(potential.begin(), potential.end(), 0);
+        excess.assign(n + 1, 0);
+        current.resize(n + 1);
+        for (long long epsilon = maxCost; epsilon > 1; ) {
+            epsilon = max(1LL, epsilon / ALPHA);
+            refine(epsilon);
+        }
+        network.cost.swap(originalCost);
+        return total;
+    }
+
+    void refine(long long epsilon) {
+        for (int a = 0; a < network.arcCount(); a++) {
+            Cap r = network.residual[a];
+            if (r > 0 && reducedCost(a) < 0) {
+                network.residual[a] = 0;
+                network.residual[network.rev[a]] += r;
+                excess[tail(a)] -= r;
+                excess[network.head[a]] += r;
+            }
+        }
+        active.clear();
+        for (int v = 1; v <= n; v++) {
+            if (excess[v] > 0) {
+                active.push_back(v);
+            }
+        }
+        priceUpdate(epsilon);
+        for (size_t i = 0; i < active.size(); i++) {
+            discharge(active[i], epsilon);
+            if (relabels > n) {
+                priceUpdate(epsilon);
+            }
+        }
+    }
+
+    // Goldberg's set-relabel heuristic. A residual arc of reduced cost rc is given the
+    // length floor(rc / epsilon) + 1, or 0 when rc < 0, and d(v) is the distance from
+    // v to the nearest vertex with a deficit, capped at the largest distance D of a
+    // vertex with excess. Raising every price by epsilon * (D - d(v)) keeps the flow
+    // epsilon-optimal and gives every vertex with excess an admissible path to a
+    // deficit. The distances come from a Dijkstra search backwards from the deficits.
+    void priceUpdate(long long epsilon) {
+        relabels = 0;
+        for (int v : touched) {
+            dist[v] = COST_INF;
+        }
+        touched.clear();
+        heap.clear();
+        int remaining = 0;
+        for (int v = 1; v <= n; v++) {
+            current[v] = network.offsets[v];
+            remaining += excess[v] > 0;
+            if (excess[v] < 0) {
+                dist[v] = 0;
+                touched.push_back(v);
+                heap.push(0, v);
+            }
+        }
+        long long reached = 0;
+        while (remaining > 0 && !heap.empty()) {
+            auto top = heap.pop();
+            int w = top.second;
+            if (top.first != dist[w]) {
+                continue;
+            }
+            reached = top.first;
+            remaining -= excess[w] > 0;
+            for (int a = network.offsets[w]; a < network.offsets[w + 1]; a++) {
+                int b = network.rev[a];
+                if (network.residual[b] <= 0) {
+                    continue;
+                }
+                int v = network.head[a];
+                long long rc = reducedCost(b);
+                long long d = top.first + (rc < 0 ? 0 : rc / epsilon + 1);
+                if (d < dist[v]) {
+                    if (dist[v] == COST_INF) {
+                        touched.push_back(v);
+                    }
+                    dist[v] = d;
+                    heap.push(d, v);
+                }
+            }
+        }
+        for (int v : touched) {
+            potential[v] += epsilon * (reached - min(dist[v], reached));
+        }
+    }
+
+    // Pushes the excess of u along arcs of negative reduced cost; when none is left,
+    // lowers u's price so that its cheapest residual arc has reduced cost -epsilon.
+    void discharge(int u, long long epsilon) {
+        while (excess[u] > 0) {
+            if (current[u] == network.offsets[u + 1]) {
+                long long highest = numeric_limits<long long>::min();
+                for (int a = network.offsets[u]; a < network.offsets[u + 1]; a++) {
+                    if (network.residual[a] > 0) {
+                        highest = max(highest, potential[network.head[a]] - network.cost[a]);
+                    }
+                }
+                potential[u] = highest - epsilon;
+                current[u] = network.offsets[u];
+                relabels++;
+                continue;
+            }
+            int a = current[u];
+            Cap r = network.residual[a];
+            if (r > 0 && reducedCost(a) < 0) {
+                int v = network.head[a];
+                Cap amount = min(excess[u], r);
+                network.residual[a] -= amount;
+                network.residual[network.rev[a]] += amount;
+                if (excess[v] <= 0 && excess[v] + amount > 0) {
+                    active.push_back(v);
+                }
+                excess[v] += amount;
+                excess[u] -= amount;
+            } else {
+                current[u]++;
+            }
+        }
+    }
+};
+
+typedef BasicMinCostFlow<long long> MinCostFlow;
+
+#endif // MIN_COST_FLOW_HPP
@@ -0,0 +1,259 @@
+#ifndef PARALLEL_PUSH_RELABEL_HPP
+#define PARALLEL_PUSH_RELABEL_HPP
+
+#include "GraphGenerator.hpp"
+#include "FlowEdge.hpp"
+#include "ThreadPool.hpp"
+#include <bits/stdc++.h>
+
+// -----------------------------------------------------------------------------
+// Synchronous parallel push-relabel maximum flow (Baumstark, Blelloch and Shun).
+// It works on the CSR arrays of the network directly, with an atomic copy of the
+// residual capacities, so Cap must be an integral type.
+//
+// Every round discharges all active vertices of the working set in parallel. Each
+// vertex reads the heights fixed at the start of the round and relabels only its
+// own copy; a push to another active vertex is allowed only if v "wins" against it,
+// which rules out pushes in both directions between two active vertices. Residual
+// capacities are updated atomically and pushed excess is collected in an atomic
+// per-vertex counter that is folded in after the round, together with the new
+// heights. Global relabels are parallel level-synchronous reverse BFS runs from
+// the target, started whenever the relabel work since the last one exceeds
+// O(n + m) and whenever the working set runs empty.
+//
+// Like PushRelabel, the first phase computes a maximum preflow (minCutValue()) and
+// the second returns stranded excess to the source (maxFlow()). The resulting
+// residual capacities are written back into the network.
+// -----------------------------------------------------------------------------
+template <class Cap>
+class BasicParallelPushRelabel {
+  public:
+    BasicParallelPushRelabel(BasicFlowNetwork<Cap>& network, ThreadPool& pool)
+        : network(network), n(network.n), pool(pool),
+          offsets(network.offsets), head(network.head), rev(network.rev),
+          residual(network.arcCount()), height(network.n + 1), addedExcess(network.n + 1),
+          queued(network.n + 1), excess(network.n + 1), newHeight(network.n + 1),
+          workingStamp(network.n + 1, -1), lists(pool.size()), workDone(pool.size()) {}
+
+    Cap maxFlow(int s, int t) {
+        Cap value = preflow(s, t);
+        runPhase(s, t);
+        writeBack();
+        return value;
+    }
+
+    // First phase only: leaves a maximum preflow in the network and returns its value.
+    Cap minCutValue(int s, int t) {
+        Cap value = preflow(s, t);
+        writeBack();
+        return value;
+    }
+
+  private:
+    BasicFlowNetwork<Cap>& network;
+    int n;
+    ThreadPool& pool;
+    const vector<int>& offsets;
+    const vector<int>& head;
+    const vector<int>& rev;
+    vector<atomic<Cap>> residual;
+    vector<atomic<int>> height;
+    vector<atomic<Cap>> addedExcess;  // excess pushed into each vertex this round
+    vector<atomic<char>> queued;      // already in the next working set
+    vector<Cap> excess;
+    vector<int> newHeight;
+    vector<int> workingStamp;         // round in which the vertex was active
+    vector<int> working;
+    vector<vector<int>> lists;        // per-worker output of parallel steps
+    vector<long long> workDone;       // per-worker relabel work
+    int round = 0;
+
+    Cap preflow(int s, int t) {
+        if (s == t) {
+            throw runtime_error("Source and sink must differ!");
+        }
+        pool.parallelFor(network.arcCount(), [&](int a, int) {
+            residual[a].store(network.residual[a], memory_order_relaxed);
+        }, 4096);
+        fill(excess.begin(), excess.end(), 0);
+        for (int a = offsets[s]; a < offsets[s + 1]; a++) {
+            Cap amount = residual[a].load(memory_order_relaxed);
+            if (amount > 0) {
+                residual[a].store(0, memory_order_relaxed);
+                residual[rev[a]].fetch_add(amount, memory_order_relaxed);
+                excess[head[a]] += amount;
+                excess[s] -= amount;
+            }
+        }
+        runPhase(t, s);
+        return excess[t];
+    }
+
+    void writeBack() {
+        pool.parallelFor(network.arcCount(), [&](int a, int) {
+            network.residual[a] = residual[a].load(memory_order_relaxed);
+        }, 4096);
+    }
+
+    // Collects the per-worker lists into `out`.
+    void gather(vector<int>& out) {
+        out.clear();
+        for (auto& list : lists) {
+            out.insert(out.end(), list.begin(), list.end());
+            list.clear();
+        }
+    }
+
+    // Sets every height to the residual distance to target (n when unreachable;
+    // `other` stays at n) by a level-synchronous parallel BFS, and rebuilds the
+    // working set from the vertices with excess.
+    void globalRelabel(int target, int other) {
+        pool.parallelFor(n + 1, [&](int v, int) {
+            height[v].store(n, memory_order_relaxed);
+        }, 1024);
+        height[target].store(0, memory_order_relaxed);
+        vector<int> frontier(1, target), next;
+        for (int level = 1; !frontier.empty(); level++) {
+            pool.parallelFor((int)frontier.size(), [&](int i, int worker) {
+                int v = frontier[i];
+                for (int a = offsets[v]; a < offsets[v + 1]; a++) {
+                    int u = head[a];
+                    int unreached = n;
+                    if (u != other && residual[rev[a]].load(memory_order_relaxed) > 0 &&
+                        height[u].load(memory_order_relaxed) == n &&
+                        height[u].compare_exchange_strong(unreached, level, memory_order_relaxed)) {
+                        lists[worker].push_back(u);
+                    }
+                }
+            }, 64);
+            gather(next);
+            frontier.swap(next);
+        }
+        pool.parallelFor(n, [&](int i, int worker) {
+            int v = i + 1;
+            if (v != target && excess[v] > 0 && height[v].load(memory_order_relaxed) < n) {
+                lists[worker].push_back(v);
+            }
+        }, 1024);
+        gather(working);
+    }
+
+    // Discharges v against the heights fixed at the start of the round. Returns the
+    // remaining excess; v's new height is left in newHeight[v].
+    Cap discharge(int v, int target, int worker) {
+        Cap e = excess[v];
+        int oldHeight = height[v].load(memory_order_relaxed);
+        int h = oldHeight;
+        while (e > 0) {
+            int lowest = n;
+            bool skipped = false;
+            for (int a = offsets[v]; a < offsets[v + 1] && e > 0; a++) {
+                Cap r = residual[a].load(memory_order_relaxed);
+                if (r <= 0) {
+                    continue;
+                }
+                int w = head[a];
+                int hw = height[w].load(memory_order_relaxed);
+                bool admissible = h == hw + 1;
+                if (admissible && workingStamp[w] == round) {
+                    bool wins = oldHeight == hw + 1 || oldHeight < hw - 1 || (oldHeight == hw && v < w);
+                    if (!wins) {
+                        skipped = true;
+                        continue;
+                    }
+                }
+                if (admissible) {
+                    Cap amount = min(r, e);
+                    residual[a].fetch_sub(amount, memory_order_relaxed);
+                    residual[rev[a]].fetch_add(amount, memory_order_relaxed);
+                    addedExcess[w].fetch_add(amount, memory_order_relaxed);
+                    e -= amount;
+                    if (w != target && !queued[w].exchange(1, memory_order_relaxed)) {
+                        lists[worker].push_back(w);
+                    }
+                    r -= amount;
+                }
+                if (r > 0 && hw >= h) {
+                    lowest = min(lowest, hw + 1);
+                }
+            }
+            if (e == 0 || skipped) {
+                break;
+            }
+            workDone[worker] += offsets[v + 1] - offsets[v] + 12;
+            h = lowest;
+            if (h >= n) {
+                h = n;
+                break;
+            }
+        }
+        newHeight[v] = h;
+        if (e > 0 && h < n && !queued[v].exchange(1, memory_order_relaxed)) {
+            lists[worker].push_back(v);
+        }
+        return e;
+    }
+
+    // Runs synchronous rounds until no vertex that can still reach target has excess.
+    // `other` is the opposite terminal and is never discharged.
+    //
+    // A vertex raised in a round can still receive excess in it from a neighbour that
+    // read its old height, which leaves a residual arc that the new height makes
+    // invalid. A height of n is then no proof that the excess is stranded, so the
+    // phase only ends when a global relabel, which restores exact heights, finds no
+    // active vertex.
+    void runPhase(int target, int other) {
+        long long m = offsets[n + 1];
+        long long work = 0;
+        globalRelabel(target, other);
+        bool exact = true;  // heights unchanged since the last global relabel
+        vector<int> next;
+        while (!working.empty() || !exact) {
+            if (working.empty()) {
+                work = 0;
+                globalRelabel(target, other);
+                exact = true;
+                continue;
+            }
+            exact = false;
+            round++;
+            for (int v : working) {
+                workingStamp[v] = round;
+            }
+            pool.parallelFor((int)working.size(), [&](int i, int worker) {
+                int v = working[i];
+                excess[v] = discharge(v, target, worker);
+            }, 16);
+            pool.parallelFor((int)working.size(), [&](int i, int) {
+                height[working[i]].store(newHeight[working[i]], memory_order_relaxed);
+            }, 1024);
+            gather(next);
+            // Fold in the pushed excess; the target's own counter is read at the end.
+            pool.parallelFor((int)next.size(), [&](int i, int) {
+                int v = next[i];
+                queued[v].store(0, memory_order_relaxed);
+                excess[v] += addedExcess[v].exchange(0, memory_order_relaxed);
+            }, 1024);
+            excess[target] += addedExcess[target].exchange(0, memory_order_relaxed);
+            working.clear();
+            for (int v : next) {
+                if (excess[v] > 0 && height[v].load(memory_order_relaxed) < n) {
+                    working.push_back(v);
+                }
+            }
+            for (long long& w : workDone) {
+                work += w;
+                w = 0;
+            }
+            if (work > 6LL * n + m) {
+                work = 0;
+                globalRelabel(target, other);
+                exact = true;
+            }
+        }
+    }
+};
+
+typedef BasicParallelPushRelabel<long long> ParallelPushRelabel;
+
+#endif // PARALLEL_PUSH_RELABEL_HPP
@@ -2,63 +2,107 @@
 #define PRIM_HPP
 
 #include <bits/stdc++.h>
+#include "CsrGraph.hpp"
+#include "PriorityQueues.hpp"
+#include "EpochArray.hpp"
 
 typedef tuple<int, int, int> Edge;
 
-pair<int, vector<tuple<int, int, int>>> prim(const Graph& graph) {
+// State of prim(), reusable across calls: the tree membership marks (epoch-stamped,
+// so they reset in O(1)), both queues and the output tree keep their memory, so
+// repeated calls with one workspace allocate nothing once it has grown.
+struct PrimWorkspace {
+    EpochArray<char> inTree;
+    BucketQueue<pair<int, int>> buckets;
+    BinaryHeapQueue<pair<int, int>> heap;
+    vector<tuple<int, int, int>> tree;
+};
+
+// Prim's algorithm with the priority queue supplied by the caller (see PriorityQueues.hpp).
+// Queue entries are keyed by weight and carry the edge's endpoints, smaller first, so
+// weight ties are broken as in lighterEdge(). The tree edges are written to mst
+// oriented and sorted by lighterEdge(), like kruskal() and boruvka() return them,
+// and the tree weight is returned.
+template <class Queue>
+long long prim(const CsrGraph& graph, Queue& pq, EpochArray<char>& inMST, vector<tuple<int, int, int>>& mst) {
     if (graph.isDirected) {
         throw runtime_error("Prim only for undirected!");
     }
 
     int n = graph.vertexCount;
-    vector<vector<pair<int, int>>> adj(n + 1);
-    for (const auto& edge : graph.edges) {
-        int u, v, w;
-        tie(u, v, w) = edge;
-        adj[u].push_back({v, w});
-        adj[v].push_back({u, w});
-    }
-
-    vector<tuple<int, int, int>> mst;
-    int totalWeight = 0;
 
-    vector<bool> inMST(n + 1, false);
+    mst.clear();
+    long long totalWeight = 0;
 
-    priority_queue<Edge, vector<Edge>, greater<Edge>> pq;
+    inMST.resize(n + 1);
+    inMST.reset();
 
     int start = 1;
-    inMST[start] = true;
+    inMST.set(start, true);
 
-    for (const auto &p : adj[start]) {
-        int to = p.first;
-        int weight = p.second;
-        pq.push(make_tuple(weight, start, to));
+    for (int a = graph.offsets[start]; a < graph.offsets[start + 1]; a++) {
+        pq.push(graph.weights[a], make_pair(min(start, graph.targets[a]), max(start, graph.targets[a])));
     }
 
     int counter = 1;
 
     while (!pq.empty() && counter < n) {
-        int weight, u, v;
-        tie(weight, u, v) = pq.top();
-        pq.pop();
+        auto top = pq.pop();
+        int weight = top.first;
+        int u = top.second.first;
+        int v = top.second.second;
 
-        if (inMST[v]) continue;
+        if (inMST.isSet(u) && inMST.isSet(v)) continue;
 
-        inMST[v] = true;
-        totalWeight += weight;
         mst.push_back(make_tuple(u, v, weight));
+        if (inMST.isSet(v)) v = u;
+        inMST.set(v, true);
+        totalWeight += weight;
         counter++;
 
-        for (const auto &p : adj[v]) {
-            int to = p.first;
-            int w = p.second;
-            if (!inMST[to]) {
-                pq.push(make_tuple(w, v, to));
+        for (int a = graph.offsets[v]; a < graph.offsets[v + 1]; a++) {
+            int to = graph.targets[a];
+            if (!inMST.isSet(to)) {
+                pq.push(graph.weights[a], make_pair(min(v, to), max(v, to)));
             }
         }
     }
 
-    return {totalWeight, mst};
+    sort(mst.begin(), mst.end(), lighterEdge);
+    return totalWeight;
+}
+
+template <class Queue>
+pair<long long, vector<tuple<int, int, int>>> prim(const CsrGraph& graph, Queue& pq) {
+    EpochArray<char> inMST;
+    vector<tuple<int, int, int>> mst;
+    long long totalWeight = prim(graph, pq, inMST, mst);
+    return {totalWeight, move(mst)};
+}
+
+// Uses a bucket queue when the weight range is small and a binary heap otherwise.
+// Prim's keys are not monotone, so the monotone Dial and radix queues do not apply.
+// Returns the tree weight and leaves the tree in ws.tree.
+inline long long prim(const CsrGraph& graph, PrimWorkspace& ws) {
+    if ((long long)graph.maxWeight - graph.minWeight <= MAX_BUCKET_QUEUE_RANGE) {
+        ws.buckets.reset(graph.minWeight, graph.maxWeight);
+        return prim(graph, ws.buckets, ws.inTree, ws.tree);
+    }
+    ws.heap.clear();
+    return prim(graph, ws.heap, ws.inTree, ws.tree);
+}
+
+pair<long long, vector<tuple<int, int, int>>> prim(const CsrGraph& graph) {
+    PrimWorkspace ws;
+    long long totalWeight = prim(graph, ws);
+    return {totalWeight, move(ws.tree)};
+}
+
+pair<long long, vector<tuple<int, int, int>>> prim(const Graph& graph) {
+    if (graph.isDirected) {
+        throw runtime_error("Prim only for undirected!");
+    }
+    return prim(buildCsrGraph(graph));
 }
 
 #endif // PRIM_HPP
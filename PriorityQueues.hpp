@@ -0,0 +1,236 @@
+#ifndef PRIORITY_QUEUES_HPP
+#define PRIORITY_QUEUES_HPP
+
+#include <algorithm>
+#include <functional>
+#include <utility>
+#include <vector>
+using namespace std;
+
+// -----------------------------------------------------------------------------
+// Priority queue policies with integer keys, used by Dijkstra and Prim.
+// All of them share one interface:
+//   push(key, value), pop() -> (key, value) with the smallest key, empty(), clear().
+// Stale entries are not removed; callers skip them on pop (lazy deletion).
+// BinaryHeapQueue and BucketQueue pop equal keys in increasing value order, so
+// results that depend on tie-breaking (Prim's tree) do not depend on the policy.
+//
+// - BinaryHeapQueue: general purpose, O(log n) per operation. Its key type is a
+//                    parameter (int by default) and may be any ordered type, e.g.
+//                    the float or double distances of dijkstra().
+// - DialQueue:       monotone keys that never exceed the last popped key by more than
+//                    maxStep (Dijkstra with weights in [0, maxStep]); O(1) amortized.
+// - BucketQueue:     arbitrary keys from a small fixed range [minKey, maxKey]
+//                    (Prim with bounded weights); each bucket is a small heap of
+//                    values, pop scans the buckets.
+// - RadixHeap:       monotone non-negative keys of any size; O(log C) amortized.
+//                    Its key type is a parameter (int by default), so searches
+//                    with 64-bit distances can use it too.
+// -----------------------------------------------------------------------------
+
+template <class T, class Key = int>
+class BinaryHeapQueue {
+  public:
+    void push(Key key, const T& value) {
+        heap.emplace_back(key, value);
+        push_heap(heap.begin(), heap.end(), greater<pair<Key, T>>());
+    }
+
+    pair<Key, T> pop() {
+        pop_heap(heap.begin(), heap.end(), greater<pair<Key, T>>());
+        pair<Key, T> top = heap.back();
+        heap.pop_back();
+        return top;
+    }
+
+    bool empty() const {
+        return heap.empty();
+    }
+
+    void clear() {
+        heap.clear();
+    }
+
+  private:
+    vector<pair<Key, T>> heap;
+};
+
+template <class T>
+class DialQueue {
+  public:
+    explicit DialQueue(int maxStep = 0) {
+        reset(maxStep);
+    }
+
+    // Empties the queue and prepares it for keys that grow by at most maxStep
+    // per pop, starting from 0. The entry store keeps its capacity, so a reused
+    // queue stops allocating once it has held its largest number of entries.
+    void reset(int maxStep) {
+        clear();
+        heads.assign(maxStep + 1, -1);
+    }
+
+    void push(int key, const T& value) {
+        int& head = heads[key % heads.size()];
+        int node = freeNode;
+        if (node >= 0) {
+            freeNode = next[node];
+            values[node] = value;
+        } else {
+            node = static_cast<int>(values.size());
+            values.push_back(value);
+            next.push_back(-1);
+        }
+        next[node] = head;
+        head = node;
+        count++;
+    }
+
+    pair<int, T> pop() {
+        while (heads[cursor % heads.size()] < 0) {
+            cursor++;
+        }
+        int& head = heads[cursor % heads.size()];
+        int node = head;
+        head = next[node];
+        next[node] = freeNode;
+        freeNode = node;
+        count--;
+        return {cursor, values[node]};
+    }
+
+    bool empty() const {
+        return count == 0;
+    }
+
+    void clear() {
+        fill(heads.begin(), heads.end(), -1);
+        values.clear();
+        next.clear();
+        freeNode = -1;
+        cursor = 0;
+        count = 0;
+    }
+
+  private:
+    // Bucket key % size() is a stack of the entries with that key, linked through
+    // next[] from heads[]; popped nodes go on the free list and are reused first.
+    vector<int> heads;
+    vector<T> values;
+    vector<int> next;
+    int freeNode = -1;
+    int cursor = 0;             // key of the last pop; no entry has a smaller key
+    size_t count = 0;
+};
+
+template <class T>
+class BucketQueue {
+  public:
+    BucketQueue(int minKey = 0, int maxKey = 0) {
+        reset(minKey, maxKey);
+    }
+
+    // Empties the queue and prepares it for keys in [minKey, maxKey].
+    void reset(int minKey, int maxKey) {
+        clear();
+        this->minKey = minKey;
+        buckets.resize(maxKey - minKey + 1);
+    }
+
+    void push(int key, const T& value) {
+        int index = key - minKey;
+        buckets[index].push_back(value);
+        push_heap(buckets[index].begin(), buckets[index].end(), greater<T>());
+        cursor = min(cursor, index);
+        count++;
+    }
+
+    pair<int, T> pop() {
+        while (buckets[cursor].empty()) {
+            cursor++;
+        }
+        pop_heap(buckets[cursor].begin(), buckets[cursor].end(), greater<T>());
+        T value = buckets[cursor].back();
+        buckets[cursor].pop_back();
+        count--;
+        return {cursor + minKey, value};
+    }
+
+    bool empty() const {
+        return count == 0;
+    }
+
+    void clear() {
+        for (auto& bucket : buckets) {
+            bucket.clear();
+        }
+        cursor = 0;
+        count = 0;
+    }
+
+  private:
+    vector<vector<T>> buckets;
+    int minKey = 0;
+    int cursor = 0;  // no bucket below cursor holds entries
+    size_t count = 0;
+};
+
+template <class T, class Key = int>
+class RadixHeap {
+  public:
+    void push(Key key, const T& value) {
+        buckets[bucketOf(key)].emplace_back(key, value);
+        count++;
+    }
+
+    pair<Key, T> pop() {
+        if (buckets[0].empty()) {
+            // Redistribute the lowest non-empty bucket around its minimum key; every
+            // entry moves to a strictly lower bucket, which bounds the total work.
+            int i = 1;
+            while (buckets[i].empty()) {
+                i++;
+            }
+            last = buckets[i][0].first;
+            for (const auto& entry : buckets[i]) {
+                last = min(last, entry.first);
+            }
+            for (const auto& entry : buckets[i]) {
+                buckets[bucketOf(entry.first)].push_back(entry);
+            }
+            buckets[i].clear();
+        }
+        pair<Key, T> top = buckets[0].back();
+        buckets[0].pop_back();
+        count--;
+        return top;
+    }
+
+    bool empty() const {
+        return count == 0;
+    }
+
+    void clear() {
+        for (auto& bucket : buckets) {
+            bucket.clear();
+        }
+        last = 0;
+        count = 0;
+    }
+
+  private:
+    static const int BITS = sizeof(Key) * 8;
+    vector<pair<Key, T>> buckets[BITS + 1];  // bucket i holds keys whose highest bit differing from last is i - 1
+    Key last = 0;                            // key of the last pop; no entry has a smaller key
+    size_t count = 0;
+
+    int bucketOf(Key key) const {
+        unsigned long long diff = static_cast<unsigned long long>(key) ^ static_cast<unsigned long long>(last);
+        return diff == 0 ? 0 : 64 - __builtin_clzll(diff);
+    }
+};
+
+// Largest key range for which bucket-based queues are preferred over heaps.
+const int MAX_BUCKET_QUEUE_RANGE = 1 << 16;
+
+#endif // PRIORITY_QUEUES_HPP
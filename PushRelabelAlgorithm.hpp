@@ -0,0 +1,238 @@
+#ifndef PUSH_RELABEL_ALGORITHM_HPP
+#define PUSH_RELABEL_ALGORITHM_HPP
+
+#include "GraphGenerator.hpp"
+#include "FlowEdge.hpp"
+#include <bits/stdc++.h>
+
+// -----------------------------------------------------------------------------
+// Highest-label push-relabel maximum flow (Goldberg-Tarjan, with the heuristics of
+// Cherkassky and Goldberg's HIPR). Active vertices are kept in one bucket per height
+// and the highest one is discharged first. Heights are recomputed exactly by a
+// reverse BFS from the sink (global relabel) at the start and after every
+// O(n + m) units of relabel work, and the gap heuristic lifts every vertex above
+// an empty height to n, since none of them can reach the sink any more.
+//
+// The solver works in two phases. The first computes a maximum preflow; its value
+// is the min-cut value and the vertices that cannot reach the sink in the residual
+// network form the source side of a minimum cut. The second returns the excess
+// stranded at those vertices to the source, which turns the preflow into a maximum
+// flow. minCutValue() runs only the first phase; maxFlow() runs both.
+// -----------------------------------------------------------------------------
+template <class Cap>
+class BasicPushRelabel {
+  public:
+    BasicPushRelabel(BasicFlowNetwork<Cap>& network) : network(network), n(network.n) {
+        height.resize(n + 1);
+        current.resize(n + 1);
+        excess.resize(n + 1);
+        activeHead.resize(n + 1);
+        activeNext.resize(n + 1);
+        allHead.resize(n + 1);
+        allNext.resize(n + 1);
+        allPrev.resize(n + 1);
+        queue.resize(n + 1);
+    }
+
+    Cap maxFlow(int s, int t) {
+        Cap value = minCutValue(s, t);
+        runPhase(s, t);
+        return value;
+    }
+
+    // First phase only: leaves a maximum preflow in the network and returns its value.
+    Cap minCutValue(int s, int t) {
+        if (s == t) {
+            throw runtime_error("Source and sink must differ!");
+        }
+        fill(excess.begin(), excess.end(), 0);
+        for (int a = network.offsets[s]; a < network.offsets[s + 1]; a++) {
+            Cap amount = network.residual[a];
+            if (amount > 0) {
+                network.residual[a] = 0;
+                network.residual[network.rev[a]] += amount;
+                excess[network.head[a]] += amount;
+                excess[s] -= amount;
+            }
+        }
+        runPhase(t, s);
+
+        // Vertices the final global relabel cannot reach from the sink.
+        globalRelabel(t, s);
+        cutSide.clear();
+        for (int v = 1; v <= n; v++) {
+            if (height[v] >= n) {
+                cutSide.push_back(v);
+            }
+        }
+        return excess[t];
+    }
+
+    // Source side of the minimum cut found by the last minCutValue() or maxFlow().
+    const vector<int>& minCutSourceSide() const {
+        return cutSide;
+    }
+
+  private:
+    BasicFlowNetwork<Cap>& network;
+    int n;
+    vector<int> height;
+    vector<int> current;       // current arc of each vertex
+    vector<Cap> excess;
+    vector<int> activeHead;    // per height: stack of active vertices
+    vector<int> activeNext;
+    vector<int> allHead;       // per height: doubly linked list of all vertices below n
+    vector<int> allNext;
+    vector<int> allPrev;
+    vector<int> queue;         // global relabel BFS buffer
+    int maxActive;             // no active vertex is above maxActive
+    int maxHeight;             // no listed vertex is above maxHeight
+    long long work;            // relabel work since the last global relabel
+    vector<int> cutSide;
+
+    void addActive(int v) {
+        activeNext[v] = activeHead[height[v]];
+        activeHead[height[v]] = v;
+        maxActive = max(maxActive, height[v]);
+    }
+
+    void addToList(int v) {
+        int h = height[v];
+        allPrev[v] = -1;
+        allNext[v] = allHead[h];
+        if (allHead[h] != -1) {
+            allPrev[allHead[h]] = v;
+        }
+        allHead[h] = v;
+        maxHeight = max(maxHeight, h);
+    }
+
+    void removeFromList(int v) {
+        int h = height[v];
+        if (allPrev[v] != -1) {
+            allNext[allPrev[v]] = allNext[v];
+        } else {
+            allHead[h] = allNext[v];
+        }
+        if (allNext[v] != -1) {
+            allPrev[allNext[v]] = allPrev[v];
+        }
+    }
+
+    // Sets every height to the exact residual distance to target (n when target is
+    // unreachable; `other` stays at n) and rebuilds the buckets.
+    void globalRelabel(int target, int other) {
+        fill(height.begin(), height.end(), n);
+        fill(activeHead.begin(), activeHead.end(), -1);
+        fill(allHead.begin(), allHead.end(), -1);
+        maxActive = -1;
+        maxHeight = 0;
+        work = 0;
+        height[target] = 0;
+        int head = 0, tail = 0;
+        queue[tail++] = target;
+        while (head < tail) {
+            int v = queue[head++];
+            for (int a = network.offsets[v]; a < network.offsets[v + 1]; a++) {
+                int u = network.head[a];
+                if (height[u] == n && u != other && network.residual[network.rev[a]] > 0) {
+                    height[u] = height[v] + 1;
+                    queue[tail++] = u;
+                }
+            }
+        }
+        for (int i = 0; i < tail; i++) {
+            int v = queue[i];
+            current[v] = network.offsets[v];
+            addToList(v);
+            if (v != target && excess[v] > 0) {
+                addActive(v);
+            }
+        }
+    }
+
+    // Lifts v to one above its lowest residual neighbour. If v was the last vertex at
+    // its height, the gap heuristic lifts v and every vertex above it to n instead.
+    void relabel(int v) {
+        int oldHeight = height[v];
+        removeFromList(v);
+        if (allHead[oldHeight] == -1) {
+            for (int h = oldHeight + 1; h <= maxHeight; h++) {
+                for (int u = allHead[h]; u != -1; u = allNext[u]) {
+                    height[u] = n;
+                }
+                allHead[h] = -1;
+                activeHead[h] = -1;
+            }
+            height[v] = n;
+            maxHeight = oldHeight - 1;
+            maxActive = min(maxActive, oldHeight - 1);
+            return;
+        }
+        int newHeight = n;
+        for (int a = network.offsets[v]; a < network.offsets[v + 1]; a++) {
+            if (network.residual[a] > 0 && height[network.head[a]] + 1 < newHeight) {
+                newHeight = height[network.head[a]] + 1;
+                current[v] = a;
+            }
+        }
+        work += network.offsets[v + 1] - network.offsets[v] + 12;
+        height[v] = newHeight;
+        if (newHeight < n) {
+            addToList(v);
+        }
+    }
+
+    // Pushes the excess of v along admissible arcs, relabelling when none is left,
+    // until v has no excess or can no longer reach the target.
+    void discharge(int v, int target) {
+        while (excess[v] > 0) {
+            if (current[v] == network.offsets[v + 1]) {
+                relabel(v);
+                if (height[v] >= n) {
+                    return;
+                }
+                continue;
+            }
+            int a = current[v];
+            int w = network.head[a];
+            Cap r = network.residual[a];
+            if (r > 0 && height[v] == height[w] + 1) {
+                Cap amount = min(excess[v], r);
+                network.residual[a] -= amount;
+                network.residual[network.rev[a]] += amount;
+                if (excess[w] == 0 && w != target) {
+                    addActive(w);
+                }
+                excess[w] += amount;
+                excess[v] -= amount;
+            } else {
+                current[v]++;
+            }
+        }
+    }
+
+    // Discharges active vertices, highest first, until no vertex that can still reach
+    // target has excess. `other` is the opposite terminal and is never discharged.
+    void runPhase(int target, int other) {
+        globalRelabel(target, other);
+        while (true) {
+            while (maxActive >= 0 && activeHead[maxActive] == -1) {
+                maxActive--;
+            }
+            if (maxActive < 0) {
+                break;
+            }
+            int v = activeHead[maxActive];
+            activeHead[maxActive] = activeNext[v];
+            discharge(v, target);
+            if (work > 6LL * n + network.arcCount()) {
+                globalRelabel(target, other);
+            }
+        }
+    }
+};
+
+typedef BasicPushRelabel<long long> PushRelabel;
+
+#endif // PUSH_RELABEL_ALGORITHM_HPP
@@ -0,0 +1,285 @@
+#ifndef SHORTEST_PATH_QUERY_HPP
+#define SHORTEST_PATH_QUERY_HPP
+
+#include "CsrGraph.hpp"
+#include "DijkstraAlgorithm.hpp"
+#include "PriorityQueues.hpp"
+#include <algorithm>
+#include <vector>
+using namespace std;
+
+// Result of a single source-target query. distance is INF and path is empty when the
+// target is unreachable; otherwise path lists the vertices from source to target.
+struct PathResult {
+    int distance;
+    vector<int> path;
+};
+
+// One direction of a search: tentative distances and parents, reset in O(touched),
+// plus the monotone queues used by the searches.
+struct SearchSpace {
+    vector<int> dist;
+    vector<int> parent;
+    vector<int> touched;
+    DialQueue<int> dial;
+    RadixHeap<int> radix;
+
+    explicit SearchSpace(int vertexCount = 0)
+        : dist(vertexCount + 1, INF), parent(vertexCount + 1, -1) {}
+
+    void reset() {
+        for (int v : touched) {
+            dist[v] = INF;
+            parent[v] = -1;
+        }
+        touched.clear();
+    }
+
+    // Records a new tentative distance for v reached from p.
+    void reach(int v, int d, int p) {
+        if (dist[v] == INF)
+            touched.push_back(v);
+        dist[v] = d;
+        parent[v] = p;
+    }
+};
+
+// Heuristic for plain Dijkstra: A* with it settles vertices in Dijkstra order.
+struct ZeroHeuristic {
+    int operator()(int) const {
+        return 0;
+    }
+};
+
+// -----------------------------------------------------------------------------
+// ALT (A*, landmarks, triangle inequality) preprocessing. Distances from and to a few
+// landmarks are precomputed with dijkstra() on the forward and reverse graphs; the
+// triangle inequality then gives, for every target t, a consistent lower bound
+//   h(v) = max over landmarks L of max(d(L,t) - d(L,v), d(v,L) - d(t,L)).
+// Landmarks are chosen greedily, each one farthest from those already chosen.
+// -----------------------------------------------------------------------------
+class AltLandmarks {
+  public:
+    class Heuristic {
+      public:
+        Heuristic(const AltLandmarks& landmarks, int target) : landmarks(landmarks) {
+            for (size_t i = 0; i < landmarks.from.size(); i++) {
+                fromTarget.push_back(landmarks.from[i][target]);
+                toTarget.push_back(landmarks.to[i][target]);
+            }
+        }
+
+        // Returns INF for vertices that provably cannot reach the target: those reachable
+        // from a landmark that cannot reach the target, or that cannot reach a landmark
+        // the target reaches. Keeping these cases makes the bound consistent.
+        int operator()(int v) const {
+            int bound = 0;
+            for (size_t i = 0; i < fromTarget.size(); i++) {
+                int fromV = landmarks.from[i][v];
+                int toV = landmarks.to[i][v];
+                if (fromV < INF)
+                    bound = max(bound, fromTarget[i] < INF ? fromTarget[i] - fromV : INF);
+                if (toTarget[i] < INF)
+                    bound = max(bound, toV < INF ? toV - toTarget[i] : INF);
+            }
+            return bound;
+        }
+
+      private:
+        const AltLandmarks& landmarks;
+        vector<int> fromTarget;  // d(L, target) per landmark
+        vector<int> toTarget;    // d(target, L) per landmark
+    };
+
+    AltLandmarks(const CsrGraph& forward, const CsrGraph& backward, int count) {
+        int n = forward.vertexCount;
+        vector<int> closest(n + 1, INF);  // distance to the nearest chosen landmark
+        int next = 1;
+        for (int i = 0; i < count && i < n; i++) {
+            landmarks.push_back(next);
+            from.push_back(dijkstra(forward, next));
+            to.push_back(dijkstra(backward, next));
+            int farthest = -1;
+            for (int v = 1; v <= n; v++) {
+                if (from.back()[v] < INF)
+                    closest[v] = min(closest[v], from.back()[v]);
+                if (closest[v] > 0 && closest[v] < INF && (farthest == -1 || closest[v] > closest[farthest]))
+                    farthest = v;
+            }
+            if (farthest == -1)
+                break;
+            next = farthest;
+        }
+    }
+
+    Heuristic heuristic(int target) const {
+        return Heuristic(*this, target);
+    }
+
+    const vector<int>& getLandmarks() const {
+        return landmarks;
+    }
+
+  private:
+    vector<int> landmarks;
+    vector<vector<int>> from;  // from[i][v] = d(landmarks[i], v)
+    vector<vector<int>> to;    // to[i][v] = d(v, landmarks[i])
+};
+
+// -----------------------------------------------------------------------------
+// Point-to-point shortest path queries over a CSR graph and its reverse (build it with
+// buildReverseCsrGraph(); for undirected graphs pass the same graph twice).
+// Searches stop as soon as the target's distance is final, and the per-direction
+// search spaces are reused between queries. Edge weights must be non-negative.
+// -----------------------------------------------------------------------------
+class ShortestPathQuery {
+  public:
+    ShortestPathQuery(const CsrGraph& forward, const CsrGraph& backward)
+        : forward(forward), backward(backward),
+          forwardSpace(forward.vertexCount), backwardSpace(forward.vertexCount) {}
+
+    // Dijkstra from source that stops once target is settled.
+    PathResult query(int source, int target) {
+        if (forward.maxWeight <= MAX_BUCKET_QUEUE_RANGE) {
+            forwardSpace.dial.reset(forward.maxWeight);
+            return search(source, target, ZeroHeuristic(), forwardSpace.dial);
+        }
+        return aStarQuery(source, target, ZeroHeuristic());
+    }
+
+    // A* search guided by a consistent lower bound h(v) on the distance from v to
+    // target, e.g. ZeroHeuristic or AltLandmarks::heuristic(target). Vertices with
+    // h(v) == INF are treated as unable to reach the target and are not expanded.
+    // A consistent bound keeps the keys monotone, so a radix heap orders them.
+    template <class Heuristic>
+    PathResult aStarQuery(int source, int target, const Heuristic& h) {
+        forwardSpace.radix.clear();
+        return search(source, target, h, forwardSpace.radix);
+    }
+
+    // Bidirectional Dijkstra: a forward search from source over out-arcs and a backward
+    // search from target over in-arcs, always advancing the side with the smaller
+    // queue top. Stops once the two tops together cannot beat the best meeting point.
+    PathResult bidirectionalQuery(int source, int target) {
+        if (forward.maxWeight <= MAX_BUCKET_QUEUE_RANGE) {
+            forwardSpace.dial.reset(forward.maxWeight);
+            backwardSpace.dial.reset(forward.maxWeight);
+            return bidirectionalSearch(source, target, &SearchSpace::dial);
+        }
+        forwardSpace.radix.clear();
+        backwardSpace.radix.clear();
+        return bidirectionalSearch(source, target, &SearchSpace::radix);
+    }
+
+  private:
+    const CsrGraph& forward;
+    const CsrGraph& backward;
+    SearchSpace forwardSpace;
+    SearchSpace backwardSpace;
+
+    template <class Heuristic, class Queue>
+    PathResult search(int source, int target, const Heuristic& h, Queue& pq) {
+        SearchSpace& space = forwardSpace;
+        space.reset();
+        space.reach(source, 0, -1);
+        if (h(source) < INF)
+            pq.push(h(source), source);
+
+        while (!pq.empty()) {
+            auto top = pq.pop();
+            int u = top.second;
+            if (top.first != WeightTraits<int>::add(space.dist[u], h(u)))
+                continue;
+            if (u == target)
+                break;
+            for (int a = forward.offsets[u]; a < forward.offsets[u + 1]; a++) {
+                int v = forward.targets[a];
+                int d = WeightTraits<int>::add(space.dist[u], forward.weights[a]);
+                if (d < space.dist[v]) {
+                    int bound = h(v);
+                    if (bound >= INF)
+                        continue;
+                    space.reach(v, d, u);
+                    pq.push(WeightTraits<int>::add(d, bound), v);
+                }
+            }
+        }
+        return buildResult(target, -1);
+    }
+
+    template <class Queue>
+    PathResult bidirectionalSearch(int source, int target, Queue SearchSpace::*queue) {
+        Queue& forwardQueue = forwardSpace.*queue;
+        Queue& backwardQueue = backwardSpace.*queue;
+        forwardSpace.reset();
+        backwardSpace.reset();
+        forwardSpace.reach(source, 0, -1);
+        backwardSpace.reach(target, 0, -1);
+        forwardQueue.push(0, source);
+        backwardQueue.push(0, target);
+        int best = source == target ? 0 : INF;
+        int meeting = source == target ? source : -1;
+
+        while (!forwardQueue.empty() && !backwardQueue.empty()) {
+            pair<int, int> forwardTop = forwardQueue.pop();
+            pair<int, int> backwardTop = backwardQueue.pop();
+            if (WeightTraits<int>::add(forwardTop.first, backwardTop.first) >= best)
+                break;
+
+            bool advanceForward = forwardTop.first <= backwardTop.first;
+            pair<int, int> top = advanceForward ? forwardTop : backwardTop;
+            // Put back the top of the side that does not advance in this step.
+            if (advanceForward)
+                backwardQueue.push(backwardTop.first, backwardTop.second);
+            else
+                forwardQueue.push(forwardTop.first, forwardTop.second);
+
+            SearchSpace& space = advanceForward ? forwardSpace : backwardSpace;
+            SearchSpace& other = advanceForward ? backwardSpace : forwardSpace;
+            Queue& pq = advanceForward ? forwardQueue : backwardQueue;
+            const CsrGraph& graph = advanceForward ? forward : backward;
+            int u = top.second;
+            if (top.first != space.dist[u])
+                continue;
+            for (int a = graph.offsets[u]; a < graph.offsets[u + 1]; a++) {
+                int v = graph.targets[a];
+                int d = WeightTraits<int>::add(space.dist[u], graph.weights[a]);
+                if (d < space.dist[v]) {
+                    space.reach(v, d, u);
+                    pq.push(d, v);
+                }
+                if (other.dist[v] < INF && WeightTraits<int>::add(d, other.dist[v]) < best) {
+                    best = WeightTraits<int>::add(d, other.dist[v]);
+                    meeting = v;
+                }
+            }
+        }
+        return buildResult(target, meeting, best);
+    }
+
+    // Reads the path out of the parent pointers. With meeting == -1 the path ends in
+    // the forward search space; otherwise it is joined at meeting with the backward one.
+    PathResult buildResult(int target, int meeting, int distance = INF) {
+        PathResult result;
+        if (meeting == -1) {
+            result.distance = forwardSpace.dist[target];
+            if (result.distance == INF)
+                return result;
+            meeting = target;
+        } else {
+            result.distance = distance;
+        }
+        if (result.distance == INF)
+            return result;
+        for (int v = meeting; v != -1; v = forwardSpace.parent[v])
+            result.path.push_back(v);
+        reverse(result.path.begin(), result.path.end());
+        if (meeting != target) {
+            for (int v = backwardSpace.parent[meeting]; v != -1; v = backwardSpace.parent[v])
+                result.path.push_back(v);
+        }
+        return result;
+    }
+};
+
+#endif // SHORTEST_PATH_QUERY_HPP
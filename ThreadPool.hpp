@@ -0,0 +1,164 @@
+#ifndef THREAD_POOL_HPP
+#define THREAD_POOL_HPP
+
+#include <atomic>
+#include <condition_variable>
+#include <deque>
+#include <functional>
+#include <memory>
+#include <mutex>
+#include <thread>
+#include <vector>
+using namespace std;
+
+// -----------------------------------------------------------------------------
+// Work-stealing thread pool shared by the parallel algorithms.
+// parallelFor() splits [0, taskCount) into chunks of `grain` consecutive tasks and
+// deals them round-robin into one deque per worker. Each worker drains its own deque
+// from the back and, when it runs dry, steals chunks from the front of the other
+// deques, so uneven tasks (e.g. Dijkstra runs from different sources) stay balanced.
+// The calling thread takes part as worker 0; size() - 1 background threads are
+// started once in the constructor and reused by every call.
+// -----------------------------------------------------------------------------
+class ThreadPool {
+  public:
+    // threadCount <= 0 means one worker per hardware thread.
+    explicit ThreadPool(int threadCount = 0)
+        : threadCount_(threadCount > 0 ? threadCount : max(1, (int)thread::hardware_concurrency())),
+          body_(nullptr), generation_(0), remaining_(0), stopping_(false) {
+        for (int i = 0; i < threadCount_; i++) {
+            queues_.emplace_back(new WorkQueue());
+        }
+        for (int i = 1; i < threadCount_; i++) {
+            threads_.emplace_back(&ThreadPool::workerLoop, this, i);
+        }
+    }
+
+    ~ThreadPool() {
+        {
+            lock_guard<mutex> guard(lock_);
+            stopping_ = true;
+        }
+        wake_.notify_all();
+        for (auto& t : threads_) {
+            t.join();
+        }
+    }
+
+    ThreadPool(const ThreadPool&) = delete;
+    ThreadPool& operator=(const ThreadPool&) = delete;
+
+    int size() const {
+        return threadCount_;
+    }
+
+    // Calls body(task, worker) for every task in [0, taskCount) and returns once all of
+    // them have finished. worker is in [0, size()) and identifies the executing thread,
+    // so it can index per-thread state. body must not throw and must not call
+    // parallelFor() on the same pool.
+    void parallelFor(int taskCount, const function<void(int, int)>& body, int grain = 1) {
+        if (taskCount <= 0) {
+            return;
+        }
+        grain = max(1, grain);
+        if (threadCount_ == 1 || taskCount <= grain) {
+            for (int task = 0; task < taskCount; task++) {
+                body(task, 0);
+            }
+            return;
+        }
+
+        lock_guard<mutex> job(jobLock_);
+        int chunks = (taskCount + grain - 1) / grain;
+        {
+            lock_guard<mutex> guard(lock_);
+            body_ = &body;
+            remaining_ = chunks;
+            for (int c = 0; c < chunks; c++) {
+                WorkQueue& queue = *queues_[c % threadCount_];
+                lock_guard<mutex> queueGuard(queue.lock);
+                queue.chunks.emplace_back(c * grain, min(taskCount, (c + 1) * grain));
+            }
+            generation_++;
+        }
+        wake_.notify_all();
+
+        runChunks(0);
+        unique_lock<mutex> guard(lock_);
+        done_.wait(guard, [this] { return remaining_.load() == 0; });
+        body_ = nullptr;
+    }
+
+  private:
+    struct WorkQueue {
+        mutex lock;
+        deque<pair<int, int>> chunks;
+    };
+
+    int threadCount_;
+    vector<thread> threads_;
+    vector<unique_ptr<WorkQueue>> queues_;
+
+    mutex jobLock_;  // serializes concurrent parallelFor() callers
+    mutex lock_;
+    condition_variable wake_;
+    condition_variable done_;
+    const function<void(int, int)>* body_;
+    long long generation_;
+    atomic<int> remaining_;  // chunks of the current job that have not finished yet
+    bool stopping_;
+
+    bool popOwn(int worker, pair<int, int>& chunk) {
+        WorkQueue& queue = *queues_[worker];
+        lock_guard<mutex> guard(queue.lock);
+        if (queue.chunks.empty()) {
+            return false;
+        }
+        chunk = queue.chunks.back();
+        queue.chunks.pop_back();
+        return true;
+    }
+
+    bool steal(int worker, pair<int, int>& chunk) {
+        for (int i = 1; i < threadCount_; i++) {
+            WorkQueue& queue = *queues_[(worker + i) % threadCount_];
+            lock_guard<mutex> guard(queue.lock);
+            if (!queue.chunks.empty()) {
+                chunk = queue.chunks.front();
+                queue.chunks.pop_front();
+                return true;
+            }
+        }
+        return false;
+    }
+
+    void runChunks(int worker) {
+        pair<int, int> chunk;
+        while (popOwn(worker, chunk) || steal(worker, chunk)) {
+            for (int task = chunk.first; task < chunk.second; task++) {
+                (*body_)(task, worker);
+            }
+            if (remaining_.fetch_sub(1) == 1) {
+                lock_guard<mutex> guard(lock_);
+                done_.notify_all();
+            }
+        }
+    }
+
+    void workerLoop(int worker) {
+        long long seen = 0;
+        while (true) {
+            {
+                unique_lock<mutex> guard(lock_);
+                wake_.wait(guard, [&] { return stopping_ || generation_ != seen; });
+                if (stopping_) {
+                    return;
+                }
+                seen = generation_;
+            }
+            runChunks(worker);
+        }
+    }
+};
+
+#endif // THREAD_POOL_HPP
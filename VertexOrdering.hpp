@@ -0,0 +1,234 @@
+#ifndef VERTEX_ORDERING_HPP
+#define VERTEX_ORDERING_HPP
+
+#include "CsrGraph.hpp"
+#include <bits/stdc++.h>
+
+// -----------------------------------------------------------------------------
+// Vertex reordering for cache locality. The generator shuffles vertex ids and real
+// graphs arrive in arbitrary order, so the neighbours of a vertex are scattered over
+// every per-vertex array (distances, levels, offsets). Relabelling the vertices so
+// that neighbours get nearby ids makes those accesses hit the same cache lines.
+//
+// - Bfs:                 breadth-first order from vertex 1, then from the smallest
+//                        unvisited id for every further component.
+// - ReverseCuthillMcKee: BFS from a pseudo-peripheral vertex of each component that
+//                        visits neighbours by increasing degree, reversed. Gives a
+//                        small bandwidth on meshes and road-like graphs.
+// - DegreeSorted:        decreasing degree, ties by id, so the hubs of skewed graphs
+//                        share a few cache lines.
+//
+// The orders follow the stored arcs, i.e. the out-arcs of a directed graph.
+// VertexPermutation maps ids both ways, so results computed on the relabelled graph
+// are translated back with toOriginal().
+// -----------------------------------------------------------------------------
+enum class VertexOrder { Bfs, ReverseCuthillMcKee, DegreeSorted };
+
+// newId[v] is the new id of original vertex v and oldId[v] the original id of new
+// vertex v (1-indexed, entry 0 unused).
+struct VertexPermutation {
+    vector<int> newId;
+    vector<int> oldId;
+
+    int size() const {
+        return static_cast<int>(newId.size()) - 1;
+    }
+
+    // Per-vertex values of the relabelled graph indexed by original id.
+    template <class T>
+    vector<T> toOriginal(const vector<T>& values) const {
+        vector<T> original(values.size());
+        if (!values.empty()) {
+            original[0] = values[0];
+        }
+        for (int v = 1; v <= size(); v++) {
+            original[oldId[v]] = values[v];
+        }
+        return original;
+    }
+
+    // Edges of the relabelled graph with original endpoints. Undirected edges (as
+    // returned by the MST algorithms) are re-oriented and re-sorted by lighterEdge().
+    vector<tuple<int, int, int>> toOriginal(const vector<tuple<int, int, int>>& edges, bool isDirected) const {
+        vector<tuple<int, int, int>> original;
+        original.reserve(edges.size());
+        for (const auto& edge : edges) {
+            int u = oldId[get<0>(edge)], v = oldId[get<1>(edge)];
+            original.push_back(isDirected ? make_tuple(u, v, get<2>(edge)) : orientedEdge(u, v, get<2>(edge)));
+        }
+        if (!isDirected) {
+            sort(original.begin(), original.end(), lighterEdge);
+        }
+        return original;
+    }
+};
+
+inline VertexPermutation permutationFromOrder(const vector<int>& order) {
+    int n = static_cast<int>(order.size());
+    VertexPermutation permutation;
+    permutation.newId.assign(n + 1, 0);
+    permutation.oldId.assign(n + 1, 0);
+    for (int i = 0; i < n; i++) {
+        permutation.oldId[i + 1] = order[i];
+        permutation.newId[order[i]] = i + 1;
+    }
+    return permutation;
+}
+
+// Appends the vertices reached from root that are not yet visited to order, in BFS
+// order; with byDegree, the neighbours of each vertex are taken by increasing degree
+// (then id).
+inline void appendBfsOrder(const CsrGraph& graph, int root, bool byDegree, vector<char>& visited,
+                           vector<int>& order, vector<int>& neighbours) {
+    size_t first = order.size();
+    visited[root] = 1;
+    order.push_back(root);
+    for (size_t head = first; head < order.size(); head++) {
+        int u = order[head];
+        neighbours.clear();
+        for (int a = graph.offsets[u]; a < graph.offsets[u + 1]; a++) {
+            int v = graph.targets[a];
+            if (!visited[v]) {
+                visited[v] = 1;
+                neighbours.push_back(v);
+            }
+        }
+        if (byDegree) {
+            sort(neighbours.begin(), neighbours.end(), [&](int x, int y) {
+                return make_pair(graph.degree(x), x) < make_pair(graph.degree(y), y);
+            });
+        }
+        order.insert(order.end(), neighbours.begin(), neighbours.end());
+    }
+}
+
+// George and Liu's pseudo-peripheral vertex search among the unvisited vertices
+// reachable from start: BFS from the current candidate, move to a minimum-degree
+// vertex of the last level while the eccentricity grows (at most a few rounds).
+// level must be all -1 and is left so; queue and reached are scratch space, so a
+// search costs O(size of the part it explores), not O(n).
+inline int pseudoPeripheralVertex(const CsrGraph& graph, int start, const vector<char>& visited,
+                                  vector<int>& level, vector<int>& queue, vector<int>& reached) {
+    const int MAX_ROUNDS = 5;
+    if (graph.degree(start) == 0) {
+        return start;
+    }
+    reached.clear();
+    int candidate = start, eccentricity = -1;
+    for (int round = 0; round < MAX_ROUNDS; round++) {
+        for (int v : reached) {
+            level[v] = -1;
+        }
+        queue.assign(1, candidate);
+        level[candidate] = 0;
+        for (size_t head = 0; head < queue.size(); head++) {
+            int u = queue[head];
+            for (int a = graph.offsets[u]; a < graph.offsets[u + 1]; a++) {
+                int v = graph.targets[a];
+                if (level[v] < 0 && !visited[v]) {
+                    level[v] = level[u] + 1;
+                    queue.push_back(v);
+                }
+            }
+        }
+        reached.swap(queue);
+        int depth = level[reached.back()];
+        if (depth <= eccentricity) {
+            break;
+        }
+        eccentricity = depth;
+        int next = reached.back();
+        for (int i = static_cast<int>(reached.size()) - 1; i >= 0 && level[reached[i]] == depth; i--) {
+            if (graph.degree(reached[i]) < graph.degree(next)) {
+                next = reached[i];
+            }
+        }
+        candidate = next;
+    }
+    for (int v : reached) {
+        level[v] = -1;
+    }
+    return candidate;
+}
+
+inline VertexPermutation computeVertexOrder(const CsrGraph& graph, VertexOrder kind) {
+    int n = graph.vertexCount;
+    vector<int> order;
+    order.reserve(n);
+    if (kind == VertexOrder::DegreeSorted) {
+        for (int v = 1; v <= n; v++) {
+            order.push_back(v);
+        }
+        stable_sort(order.begin(), order.end(), [&](int x, int y) {
+            return graph.degree(x) > graph.degree(y);
+        });
+        return permutationFromOrder(order);
+    }
+
+    bool rcm = kind == VertexOrder::ReverseCuthillMcKee;
+    vector<char> visited(n + 1, 0);
+    vector<int> neighbours;
+    vector<int> level(rcm ? n + 1 : 0, -1), queue, reached;
+    for (int v = 1; v <= n; v++) {
+        // The out-arcs of a directed graph may lead from v to a peripheral vertex
+        // that does not lead back, so v can take more than one search.
+        while (!visited[v]) {
+            int root = rcm ? pseudoPeripheralVertex(graph, v, visited, level, queue, reached) : v;
+            appendBfsOrder(graph, root, rcm, visited, order, neighbours);
+        }
+    }
+    if (rcm) {
+        reverse(order.begin(), order.end());
+    }
+    return permutationFromOrder(order);
+}
+
+inline VertexPermutation computeVertexOrder(const Graph& graph, VertexOrder kind) {
+    return computeVertexOrder(buildCsrGraph(graph), kind);
+}
+
+// The graph with every vertex v renamed to permutation.newId[v]; edges keep their
+// order.
+inline Graph relabelGraph(const Graph& graph, const VertexPermutation& permutation) {
+    Graph relabelled;
+    relabelled.vertexCount = graph.vertexCount;
+    relabelled.isDirected = graph.isDirected;
+    relabelled.edges.reserve(graph.edges.size());
+    for (const auto& edge : graph.edges) {
+        relabelled.edges.emplace_back(permutation.newId[get<0>(edge)], permutation.newId[get<1>(edge)], get<2>(edge));
+    }
+    return relabelled;
+}
+
+// The CSR graph with every vertex v renamed to permutation.newId[v]. The arcs of each
+// vertex are sorted by new target id, so a scan walks the per-vertex arrays forwards.
+inline CsrGraph relabelCsrGraph(const CsrGraph& graph, const VertexPermutation& permutation) {
+    int n = graph.vertexCount;
+    CsrGraph relabelled;
+    relabelled.vertexCount = n;
+    relabelled.isDirected = graph.isDirected;
+    relabelled.minWeight = graph.minWeight;
+    relabelled.maxWeight = graph.maxWeight;
+    relabelled.offsets.assign(n + 2, 0);
+    relabelled.targets.resize(graph.arcCount());
+    relabelled.weights.resize(graph.arcCount());
+    vector<pair<int, int>> arcs;
+    for (int v = 1; v <= n; v++) {
+        int u = permutation.oldId[v];
+        arcs.clear();
+        for (int a = graph.offsets[u]; a < graph.offsets[u + 1]; a++) {
+            arcs.emplace_back(permutation.newId[graph.targets[a]], graph.weights[a]);
+        }
+        sort(arcs.begin(), arcs.end());
+        int out = relabelled.offsets[v];
+        for (const auto& arc : arcs) {
+            relabelled.targets[out] = arc.first;
+            relabelled.weights[out] = arc.second;
+            out++;
+        }
+        relabelled.offsets[v + 1] = out;
+    }
+    return relabelled;
+}
+
+#endif // VERTEX_ORDERING_HPP
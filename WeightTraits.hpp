@@ -0,0 +1,86 @@
+#ifndef WEIGHT_TRAITS_HPP
+#define WEIGHT_TRAITS_HPP
+
+#include <cstdint>
+#include <limits>
+using namespace std;
+
+// -----------------------------------------------------------------------------
+// Infinity and saturating addition for the weight types of BasicGraph, BasicCsrGraph
+// and the shortest path algorithms: int32_t (int), int64_t, float and double.
+// add(d, w) extends a distance d by an arc weight w without wrapping around: an
+// infinite d stays infinite, and integer sums are clamped to [lowest, infinity()], so
+// a path too long for the type reads as unreachable instead of as a negative
+// distance.
+//
+// int keeps 1e9, the value INF and INF_1 have always had, so int distances from
+// dijkstra(), bellmanFord() and the code built on them still compare equal; int64_t
+// uses its maximum and the floating types their infinity.
+// -----------------------------------------------------------------------------
+template <class W>
+struct WeightTraits;
+
+template <>
+struct WeightTraits<int32_t> {
+    static constexpr int32_t infinity() {
+        return 1000000000;
+    }
+
+    static int32_t add(int32_t d, int32_t w) {
+        if (d >= infinity()) {
+            return infinity();
+        }
+        int64_t sum = static_cast<int64_t>(d) + w;
+        if (sum >= infinity()) {
+            return infinity();
+        }
+        return sum < numeric_limits<int32_t>::min() ? numeric_limits<int32_t>::min() : static_cast<int32_t>(sum);
+    }
+};
+
+// 64-bit integers: int64_t is long on LP64 Linux but long long elsewhere, and the code
+// base uses long long, so both get these traits.
+template <class W>
+struct Int64WeightTraits {
+    static constexpr W infinity() {
+        return numeric_limits<W>::max();
+    }
+
+    static W add(W d, W w) {
+        W sum;
+        if (d == infinity() || __builtin_add_overflow(d, w, &sum)) {
+            return d == infinity() || w > 0 ? infinity() : numeric_limits<W>::min();
+        }
+        return sum;
+    }
+};
+
+template <>
+struct WeightTraits<long> : Int64WeightTraits<long> {};
+
+template <>
+struct WeightTraits<long long> : Int64WeightTraits<long long> {};
+
+template <>
+struct WeightTraits<float> {
+    static constexpr float infinity() {
+        return numeric_limits<float>::infinity();
+    }
+
+    static float add(float d, float w) {
+        return d + w;
+    }
+};
+
+template <>
+struct WeightTraits<double> {
+    static constexpr double infinity() {
+        return numeric_limits<double>::infinity();
+    }
+
+    static double add(double d, double w) {
+        return d + w;
+    }
+};
+
+#endif // WEIGHT_TRAITS_HPP
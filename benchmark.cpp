@@ -0,0 +1,1568 @@
+#include <bits/stdc++.h>
+#include <sys/resource.h>
+#include <sys/ioctl.h>
+#include <sys/syscall.h>
+#include <unistd.h>
+#include <linux/perf_event.h>
+#include "GraphGenerator.hpp"
+#include "CsrGraph.hpp"
+#include "BellmanFordAlgorithm.hpp"
+#include "DijkstraAlgorithm.hpp"
+#include "BatchDijkstra.hpp"
+#include "DeltaSteppingAlgorithm.hpp"
+#include "ShortestPathQuery.hpp"
+#include "ContractionHierarchy.hpp"
+#include "PrimAlgorithm.hpp"
+#include "KruskalAlgorithm.hpp"
+#include "BoruvkaAlgorithm.hpp"
+#include "FlowEdge.hpp"
+#include "FordFulkerson.hpp"
+#include "DinicAlgorithm.hpp"
+#include "PushRelabelAlgorithm.hpp"
+#include "ParallelPushRelabel.hpp"
+#include "MinCostFlow.hpp"
+#include "GomoryHuTree.hpp"
+#include "GraphFile.hpp"
+#include "VertexOrdering.hpp"
+#include "AllPairsShortestPaths.hpp"
+
+using namespace std;
+
+// Every global allocation is counted, so benchmarkAllocations() can show how many a
+// query makes. The replacements are kept out of line: inlined, GCC pairs the malloc()
+// and free() inside them with new and delete expressions and warns of a mismatch.
+atomic<long long> allocationCount(0);
+
+__attribute__((noinline)) void* operator new(size_t size) {
+    allocationCount.fetch_add(1, memory_order_relaxed);
+    if (void* memory = malloc(size > 0 ? size : 1))
+        return memory;
+    throw bad_alloc();
+}
+
+__attribute__((noinline)) void operator delete(void* memory) noexcept {
+    free(memory);
+}
+
+__attribute__((noinline)) void operator delete(void* memory, size_t) noexcept {
+    free(memory);
+}
+
+// Runs fn once and returns its wall time in milliseconds.
+template <class F>
+double measureMs(F fn) {
+    auto begin = chrono::steady_clock::now();
+    fn();
+    auto end = chrono::steady_clock::now();
+    return chrono::duration<double, milli>(end - begin).count();
+}
+
+const unsigned long long BENCHMARK_SEED = 20240601;
+
+// Which minInArcDistance() kernels bellmanFordPull() was compiled with.
+#ifdef __AVX2__
+const char* const SIMD_KERNELS = "AVX2 kernels";
+#else
+const char* const SIMD_KERNELS = "portable kernels";
+#endif
+
+// Generates a connected weighted graph with exactly the requested size.
+Graph generateBenchmarkGraph(int vertexCount, int edgeCount, bool isDirected) {
+    GraphInputs inputs = {
+        vertexCount, vertexCount, // vertex count range
+        false,                    // isTree
+        isDirected,               // isDirected
+        true,                     // isConnected
+        false,                    // isWeaklyConnected
+        false,                    // isSemiConnected
+        true,                     // isStronglyConnected
+        0, 10,                    // edge weight range
+        edgeCount, edgeCount,     // edge count range
+        BENCHMARK_SEED,           // fixed seed, so every run sees the same graph
+        GraphModel::Default
+    };
+    GraphGenerator generator(inputs);
+    return generator.generate();
+}
+
+void printRow(const string& name, double totalMs, int calls) {
+    cout << "  " << left << setw(36) << name << right << setw(12) << fixed << setprecision(2)
+         << totalMs << " ms total" << setw(12) << totalMs / calls << " ms/call\n";
+}
+
+// Compares rebuilding the adjacency structure on every call with building one
+// CsrGraph up front and sharing it between all queries.
+void benchmarkCsr(int vertexCount, int edgeCount, int queries) {
+    cout << "\n[csr] " << vertexCount << " vertices, " << edgeCount << " edges, "
+         << queries << " queries\n";
+    Graph graph = generateBenchmarkGraph(vertexCount, edgeCount, false);
+
+    CsrGraph csr;
+    double buildMs = measureMs([&] { csr = buildCsrGraph(graph); });
+    printRow("buildCsrGraph", buildMs, 1);
+
+    long long checksum = 0;
+    double perCallMs = measureMs([&] {
+        for (int q = 0; q < queries; q++)
+            checksum += dijkstra(graph, 1 + q % vertexCount)[vertexCount];
+    });
+    double sharedMs = measureMs([&] {
+        for (int q = 0; q < queries; q++)
+            checksum -= dijkstra(csr, 1 + q % vertexCount)[vertexCount];
+    });
+    printRow("dijkstra(Graph) per-call build", perCallMs, queries);
+    printRow("dijkstra(CsrGraph) shared", sharedMs, queries);
+
+    int primRuns = max(1, queries / 4);
+    perCallMs = measureMs([&] {
+        for (int q = 0; q < primRuns; q++)
+            checksum += prim(graph).first;
+    });
+    sharedMs = measureMs([&] {
+        for (int q = 0; q < primRuns; q++)
+            checksum -= prim(csr).first;
+    });
+    printRow("prim(Graph) per-call build", perCallMs, primRuns);
+    printRow("prim(CsrGraph) shared", sharedMs, primRuns);
+
+    perCallMs = measureMs([&] { checksum += buildFlowNetwork(graph).n; });
+    sharedMs = measureMs([&] { checksum -= buildFlowNetwork(csr).n; });
+    printRow("buildFlowNetwork(Graph)", perCallMs, 1);
+    printRow("buildFlowNetwork(CsrGraph)", sharedMs, 1);
+
+    if (checksum != 0) {
+        cout << "  MISMATCH between per-call and shared results\n";
+    }
+}
+
+// Returns 1, 2, 4, ... up to the hardware thread count (always including it).
+vector<int> threadCounts() {
+    int hardware = max(1, (int)thread::hardware_concurrency());
+    vector<int> counts;
+    for (int t = 1; t < hardware; t *= 2)
+        counts.push_back(t);
+    counts.push_back(hardware);
+    return counts;
+}
+
+// Compares independent dijkstra() calls with BatchDijkstra on a shared CsrGraph
+// for several thread counts.
+void benchmarkBatch(int vertexCount, int edgeCount, int queries) {
+    cout << "\n[batch] " << vertexCount << " vertices, " << edgeCount << " edges, "
+         << queries << " sources\n";
+    Graph graph = generateBenchmarkGraph(vertexCount, edgeCount, true);
+    CsrGraph csr = buildCsrGraph(graph);
+    vector<int> sources(queries);
+    for (int q = 0; q < queries; q++)
+        sources[q] = 1 + (int)((long long)q * 7919 % vertexCount);
+
+    vector<vector<int>> expected(queries);
+    double ms = measureMs([&] {
+        for (int q = 0; q < queries; q++)
+            expected[q] = dijkstra(graph, sources[q]);
+    });
+    printRow("dijkstra(Graph) loop", ms, queries);
+
+    for (int threads : threadCounts()) {
+        ThreadPool pool(threads);
+        BatchDijkstra batch(csr, pool);
+        DistanceMatrix matrix;
+        ms = measureMs([&] { matrix = batch.run(sources); });
+        printRow("BatchDijkstra matrix, " + to_string(threads) + " threads", ms, queries);
+
+        atomic<long long> reached(0);
+        ms = measureMs([&] {
+            batch.run(sources, [&](int, const DijkstraWorkspace& ws) {
+                reached += ws.touched.size();
+            });
+        });
+        printRow("BatchDijkstra callback, " + to_string(threads) + " threads", ms, queries);
+
+        for (int q = 0; q < queries; q++) {
+            if (!equal(expected[q].begin(), expected[q].end(), matrix.row(q))) {
+                cout << "  MISMATCH for source " << sources[q] << "\n";
+                break;
+            }
+        }
+    }
+}
+
+// Measures delta-stepping against sequential dijkstra() for several thread counts,
+// then sweeps delta at the highest thread count.
+void benchmarkDeltaStepping(int vertexCount, int edgeCount, int queries) {
+    cout << "\n[delta] " << vertexCount << " vertices, " << edgeCount << " edges, "
+         << queries << " sources\n";
+    Graph graph = generateBenchmarkGraph(vertexCount, edgeCount, true);
+    CsrGraph csr = buildCsrGraph(graph);
+
+    vector<vector<int>> expected(queries);
+    double ms = measureMs([&] {
+        for (int q = 0; q < queries; q++)
+            expected[q] = dijkstra(csr, 1 + q % vertexCount);
+    });
+    printRow("dijkstra(CsrGraph)", ms, queries);
+
+    auto runSolver = [&](ThreadPool& pool, int delta) {
+        DeltaStepping solver(csr, pool, delta);
+        bool mismatch = false;
+        double solverMs = measureMs([&] {
+            for (int q = 0; q < queries; q++)
+                mismatch |= solver.run(1 + q % vertexCount) != expected[q];
+        });
+        printRow("delta-stepping, delta " + to_string(solver.getDelta()) + ", " +
+                 to_string(pool.size()) + " threads", solverMs, queries);
+        if (mismatch)
+            cout << "  MISMATCH against dijkstra()\n";
+    };
+
+    vector<int> counts = threadCounts();
+    for (int threads : counts) {
+        ThreadPool pool(threads);
+        runSolver(pool, 0);
+    }
+    ThreadPool pool(counts.back());
+    for (int delta : {1, 4, 16})
+        runSolver(pool, delta);
+}
+
+// Compares the priority queue policies of dijkstra() and prim() on one graph.
+void benchmarkQueues(int vertexCount, int edgeCount, int queries) {
+    cout << "\n[queues] " << vertexCount << " vertices, " << edgeCount << " edges, "
+         << queries << " queries\n";
+    Graph graph = generateBenchmarkGraph(vertexCount, edgeCount, false);
+    CsrGraph csr = buildCsrGraph(graph);
+    DijkstraWorkspace ws(vertexCount);
+
+    long long checksum = 0;
+    auto runDijkstra = [&](const string& name, function<void(int)> run, int sign) {
+        double ms = measureMs([&] {
+            for (int q = 0; q < queries; q++) {
+                run(1 + q % vertexCount);
+                checksum += sign * accumulate(ws.dist.begin() + 1, ws.dist.end(), 0LL);
+            }
+        });
+        printRow(name, ms, queries);
+    };
+    runDijkstra("dijkstra, binary heap", [&](int s) {
+        ws.heap.clear();
+        dijkstra(csr, s, ws, ws.heap);
+    }, 2);
+    runDijkstra("dijkstra, Dial buckets", [&](int s) {
+        ws.dial.reset(csr.maxWeight);
+        dijkstra(csr, s, ws, ws.dial);
+    }, -1);
+    runDijkstra("dijkstra, radix heap", [&](int s) {
+        ws.radix.clear();
+        dijkstra(csr, s, ws, ws.radix);
+    }, -1);
+
+    int primRuns = max(1, queries / 4);
+    double ms = measureMs([&] {
+        for (int q = 0; q < primRuns; q++) {
+            BinaryHeapQueue<pair<int, int>> pq;
+            checksum += prim(csr, pq).first;
+        }
+    });
+    printRow("prim, binary heap", ms, primRuns);
+    ms = measureMs([&] {
+        for (int q = 0; q < primRuns; q++) {
+            BucketQueue<pair<int, int>> pq(csr.minWeight, csr.maxWeight);
+            checksum -= prim(csr, pq).first;
+        }
+    });
+    printRow("prim, bucket queue", ms, primRuns);
+
+    if (checksum != 0) {
+        cout << "  MISMATCH between queue policies\n";
+    }
+}
+
+// Compares pass-based bellmanFord() with the queue-based bellmanFordQueue().
+void benchmarkBellmanFord(int vertexCount, int edgeCount, int queries) {
+    cout << "\n[bellman] " << vertexCount << " vertices, " << edgeCount << " edges, "
+         << queries << " sources\n";
+    Graph graph = generateBenchmarkGraph(vertexCount, edgeCount, true);
+    CsrGraph csr = buildCsrGraph(graph);
+
+    vector<vector<int>> expected(queries);
+    double ms = measureMs([&] {
+        for (int q = 0; q < queries; q++)
+            expected[q] = bellmanFord(csr, 1 + q % vertexCount);
+    });
+    printRow("bellmanFord, early exit", ms, queries);
+
+    bool mismatch = false;
+    ms = measureMs([&] {
+        for (int q = 0; q < queries; q++) {
+            BellmanFordResult result = bellmanFordQueue(csr, 1 + q % vertexCount);
+            mismatch |= result.hasNegativeCycle || result.dist != expected[q];
+        }
+    });
+    printRow("bellmanFordQueue", ms, queries);
+
+    CsrGraph reverse;
+    printRow("buildReverseCsrGraph", measureMs([&] { reverse = buildReverseCsrGraph(csr); }), 1);
+    ms = measureMs([&] {
+        for (int q = 0; q < queries; q++)
+            mismatch |= bellmanFordPull(reverse, 1 + q % vertexCount) != expected[q];
+    });
+    printRow(string("bellmanFordPull, ") + SIMD_KERNELS, ms, queries);
+    if (mismatch)
+        cout << "  MISMATCH against bellmanFord()\n";
+}
+
+// Runs bellmanFord(), bellmanFordPull() and dijkstra() with W weights on the graph
+// converted from int, and checks the distances against the int ones.
+template <class W>
+void benchmarkWeightType(const string& name, const CsrGraph& csr, const CsrGraph& reverse,
+                         const vector<vector<int>>& expected, bool& mismatch) {
+    BasicCsrGraph<W> graph = convertWeights<W>(csr);
+    BasicCsrGraph<W> reversed = convertWeights<W>(reverse);
+    int queries = (int)expected.size();
+    auto check = [&](int q, const vector<W>& dist) {
+        for (int v = 1; v <= csr.vertexCount; v++) {
+            W value = expected[q][v] >= INF ? WeightTraits<W>::infinity() : (W)expected[q][v];
+            mismatch |= dist[v] != value;
+        }
+    };
+    double ms = measureMs([&] {
+        for (int q = 0; q < queries; q++)
+            check(q, bellmanFord(graph, 1 + q % csr.vertexCount));
+    });
+    printRow(name + ", bellmanFord", ms, queries);
+    ms = measureMs([&] {
+        for (int q = 0; q < queries; q++)
+            check(q, bellmanFordPull(reversed, 1 + q % csr.vertexCount));
+    });
+    printRow(name + ", bellmanFordPull", ms, queries);
+    ms = measureMs([&] {
+        for (int q = 0; q < queries; q++)
+            check(q, dijkstra(graph, 1 + q % csr.vertexCount));
+    });
+    printRow(name + ", dijkstra", ms, queries);
+}
+
+// Compares the weight types int, int64_t, float and double on the same graph.
+void benchmarkWeightTypes(int vertexCount, int edgeCount, int queries) {
+    cout << "\n[weights] " << vertexCount << " vertices, " << edgeCount << " edges, "
+         << queries << " sources, " << SIMD_KERNELS << "\n";
+    CsrGraph csr = buildCsrGraph(generateBenchmarkGraph(vertexCount, edgeCount, true));
+    CsrGraph reverse = buildReverseCsrGraph(csr);
+    vector<vector<int>> expected(queries);
+    for (int q = 0; q < queries; q++)
+        expected[q] = dijkstra(csr, 1 + q % vertexCount);
+    bool mismatch = false;
+    benchmarkWeightType<int>("int", csr, reverse, expected, mismatch);
+    benchmarkWeightType<int64_t>("int64_t", csr, reverse, expected, mismatch);
+    benchmarkWeightType<float>("float", csr, reverse, expected, mismatch);
+    benchmarkWeightType<double>("double", csr, reverse, expected, mismatch);
+    if (mismatch)
+        cout << "  MISMATCH between the weight types\n";
+}
+
+// Compares full dijkstra() runs with the point-to-point query engine on random pairs.
+void benchmarkPointToPoint(int vertexCount, int edgeCount, int queries) {
+    cout << "\n[p2p] " << vertexCount << " vertices, " << edgeCount << " edges, "
+         << queries << " pairs\n";
+    Graph graph = generateBenchmarkGraph(vertexCount, edgeCount, true);
+    CsrGraph forward = buildCsrGraph(graph);
+    CsrGraph backward = buildReverseCsrGraph(forward);
+    vector<pair<int, int>> pairs(queries);
+    for (int q = 0; q < queries; q++)
+        pairs[q] = {1 + (int)((long long)q * 7919 % vertexCount), 1 + (int)((long long)q * 104729 % vertexCount)};
+
+    vector<int> expected(queries);
+    double ms = measureMs([&] {
+        for (int q = 0; q < queries; q++)
+            expected[q] = dijkstra(forward, pairs[q].first)[pairs[q].second];
+    });
+    printRow("dijkstra, full run", ms, queries);
+
+    ShortestPathQuery engine(forward, backward);
+    unique_ptr<AltLandmarks> landmarks;
+    double preprocessingMs = measureMs([&] { landmarks.reset(new AltLandmarks(forward, backward, 8)); });
+    printRow("ALT preprocessing, 8 landmarks", preprocessingMs, 1);
+
+    auto runQueries = [&](const string& name, function<PathResult(int, int)> query) {
+        bool mismatch = false;
+        double queryMs = measureMs([&] {
+            for (int q = 0; q < queries; q++)
+                mismatch |= query(pairs[q].first, pairs[q].second).distance != expected[q];
+        });
+        printRow(name, queryMs, queries);
+        if (mismatch)
+            cout << "  MISMATCH against dijkstra()\n";
+    };
+    runQueries("s-t dijkstra", [&](int s, int t) { return engine.query(s, t); });
+    runQueries("bidirectional dijkstra", [&](int s, int t) { return engine.bidirectionalQuery(s, t); });
+    runQueries("A* with ALT", [&](int s, int t) { return engine.aStarQuery(s, t, landmarks->heuristic(t)); });
+}
+
+// Preprocesses a contraction hierarchy, round-trips it through a file and validates
+// its queries against dijkstra().
+void benchmarkContractionHierarchy(int vertexCount, int edgeCount, int queries) {
+    cout << "\n[ch] " << vertexCount << " vertices, " << edgeCount << " edges, "
+         << queries << " pairs\n";
+    Graph graph = generateBenchmarkGraph(vertexCount, edgeCount, true);
+    CsrGraph forward = buildCsrGraph(graph);
+    CsrGraph backward = buildReverseCsrGraph(forward);
+
+    unique_ptr<ContractionHierarchy> built;
+    double ms = measureMs([&] { built.reset(new ContractionHierarchy(forward)); });
+    printRow("preprocessing, " + to_string(built->shortcutCount()) + " shortcuts", ms, 1);
+    string path = "ch_benchmark.bin";
+    ms = measureMs([&] { built->save(path); });
+    printRow("save", ms, 1);
+    unique_ptr<ContractionHierarchy> ch;
+    ms = measureMs([&] { ch.reset(new ContractionHierarchy(ContractionHierarchy::load(path))); });
+    printRow("load", ms, 1);
+    remove(path.c_str());
+
+    vector<pair<int, int>> pairs(queries);
+    vector<int> expected(queries);
+    for (int q = 0; q < queries; q++) {
+        pairs[q] = {1 + (int)((long long)q * 7919 % vertexCount), 1 + (int)((long long)q * 104729 % vertexCount)};
+        expected[q] = dijkstra(forward, pairs[q].first)[pairs[q].second];
+    }
+
+    ShortestPathQuery engine(forward, backward);
+    bool mismatch = false;
+    ms = measureMs([&] {
+        for (int q = 0; q < queries; q++)
+            mismatch |= engine.bidirectionalQuery(pairs[q].first, pairs[q].second).distance != expected[q];
+    });
+    printRow("bidirectional dijkstra", ms, queries);
+    ms = measureMs([&] {
+        for (int q = 0; q < queries; q++)
+            mismatch |= ch->distance(pairs[q].first, pairs[q].second) != expected[q];
+    });
+    printRow("CH distance", ms, queries);
+    ms = measureMs([&] {
+        for (int q = 0; q < queries; q++)
+            mismatch |= ch->query(pairs[q].first, pairs[q].second).distance != expected[q];
+    });
+    printRow("CH distance and unpacked path", ms, queries);
+    if (mismatch)
+        cout << "  MISMATCH against dijkstra()\n";
+}
+
+// Compares sorting every edge before the union-find pass with filter-Kruskal,
+// sequentially and in parallel, and checks the total weight against prim().
+void benchmarkKruskal(int vertexCount, int edgeCount, int queries) {
+    cout << "\n[kruskal] " << vertexCount << " vertices, " << edgeCount << " edges, "
+         << queries << " runs\n";
+    Graph graph = generateBenchmarkGraph(vertexCount, edgeCount, false);
+    long long expected = prim(graph).first;
+    bool mismatch = false;
+
+    double ms = measureMs([&] {
+        for (int q = 0; q < queries; q++) {
+            auto edges = graph.edges;
+            sort(edges.begin(), edges.end(), [](const tuple<int, int, int>& a, const tuple<int, int, int>& b) {
+                return get<2>(a) < get<2>(b);
+            });
+            DisjointSet ds(vertexCount);
+            long long totalWeight = 0;
+            for (const auto& edge : edges) {
+                if (ds.unionSets(get<0>(edge), get<1>(edge)))
+                    totalWeight += get<2>(edge);
+            }
+            mismatch |= totalWeight != expected;
+        }
+    });
+    printRow("sort all edges", ms, queries);
+    ms = measureMs([&] {
+        for (int q = 0; q < queries; q++)
+            mismatch |= kruskal(graph).first != expected;
+    });
+    printRow("filter-kruskal", ms, queries);
+    for (int threads : threadCounts()) {
+        ThreadPool pool(threads);
+        ms = measureMs([&] {
+            for (int q = 0; q < queries; q++)
+                mismatch |= kruskal(graph, pool).first != expected;
+        });
+        printRow("filter-kruskal, " + to_string(threads) + " threads", ms, queries);
+    }
+    if (mismatch)
+        cout << "  MISMATCH against prim()\n";
+}
+
+// Measures parallel Borůvka for several thread counts and checks that it returns
+// exactly the tree of kruskal() and prim().
+void benchmarkBoruvka(int vertexCount, int edgeCount, int queries) {
+    cout << "\n[boruvka] " << vertexCount << " vertices, " << edgeCount << " edges, "
+         << queries << " runs\n";
+    Graph graph = generateBenchmarkGraph(vertexCount, edgeCount, false);
+    CsrGraph csr = buildCsrGraph(graph);
+    pair<long long, vector<tuple<int, int, int>>> expected;
+    bool mismatch = false;
+
+    double ms = measureMs([&] {
+        for (int q = 0; q < queries; q++)
+            expected = prim(csr);
+    });
+    printRow("prim(CsrGraph)", ms, queries);
+    ms = measureMs([&] {
+        for (int q = 0; q < queries; q++)
+            mismatch |= kruskal(graph) != expected;
+    });
+    printRow("kruskal", ms, queries);
+    for (int threads : threadCounts()) {
+        ThreadPool pool(threads);
+        ms = measureMs([&] {
+            for (int q = 0; q < queries; q++)
+                mismatch |= boruvka(csr, pool) != expected;
+        });
+        printRow("boruvka, " + to_string(threads) + " threads", ms, queries);
+    }
+    if (mismatch)
+        cout << "  MISMATCH between prim(), kruskal() and boruvka()\n";
+}
+
+// Cross-checks the push-relabel solvers against Dinic from 1 to n on many small
+// random graphs, whose corner cases a few pairs on one large graph rarely reach.
+void crossCheckSmallFlows(int trials, bool& mismatch) {
+    ThreadPool pool(threadCounts().back());
+    int disagreements = 0;
+    for (int trial = 0; trial < trials; trial++) {
+        CounterRng rng(BENCHMARK_SEED, trial);
+        int n = 2 + (int)(rng() % 60);
+        bool isDirected = rng() % 2 == 0;
+        long long maxEdges = (long long)n * (n - 1) / (isDirected ? 1 : 2);
+        int edges = (int)min<long long>(maxEdges, n - 1 + rng() % (3 * n));
+        GraphInputs inputs = {
+            n, n,                        // vertex count range
+            false, isDirected,           // isTree, isDirected
+            false, false, false, false,  // no connectivity requirement
+            1, 1 + (int)(rng() % 30),    // capacity range
+            edges, edges,                // edge count range
+            BENCHMARK_SEED + trial,
+            GraphModel::Default
+        };
+        FlowNetwork base = buildFlowNetwork(GraphGenerator(inputs).generate());
+        FlowNetwork dinic = base, pushRelabel = base, parallel = base;
+        long long expected = Dinic(dinic).maxFlow(1, n);
+        disagreements += PushRelabel(pushRelabel).maxFlow(1, n) != expected ||
+                         ParallelPushRelabel(parallel, pool).maxFlow(1, n) != expected;
+    }
+    cout << "  " << trials << " small random graphs, " << disagreements << " disagree with dinic\n";
+    mismatch |= disagreements > 0;
+}
+
+// Compares the maximum flow solvers on the same source-sink pairs. Every solver
+// gets a fresh copy of the flow network per query.
+void benchmarkMaxFlow(int vertexCount, int edgeCount, int queries) {
+    cout << "\n[flow] " << vertexCount << " vertices, " << edgeCount << " edges, "
+         << queries << " pairs\n";
+    Graph graph = generateBenchmarkGraph(vertexCount, edgeCount, true);
+    FlowNetwork base = buildFlowNetwork(buildCsrGraph(graph));
+    vector<pair<int, int>> pairs(queries);
+    for (int q = 0; q < queries; q++) {
+        int s = 1 + (int)((long long)q * 7919 % vertexCount);
+        int t = 1 + (int)((long long)(q + 1) * 104729 % vertexCount);
+        pairs[q] = {s, t == s ? s % vertexCount + 1 : t};
+    }
+    vector<long long> expected(queries);
+    bool mismatch = false;
+
+    auto runSolver = [&](const string& name, function<long long(FlowNetwork&, int, int)> solve, bool reference) {
+        double totalMs = 0;
+        for (int q = 0; q < queries; q++) {
+            FlowNetwork network = base;
+            long long flow = 0;
+            totalMs += measureMs([&] { flow = solve(network, pairs[q].first, pairs[q].second); });
+            if (reference)
+                expected[q] = flow;
+            mismatch |= flow != expected[q];
+        }
+        printRow(name, totalMs, queries);
+    };
+    runSolver("dinic", [](FlowNetwork& network, int s, int t) {
+        return Dinic(network).maxFlow(s, t);
+    }, true);
+    runSolver("dinic, capacity scaling", [](FlowNetwork& network, int s, int t) {
+        return Dinic(network, true).maxFlow(s, t);
+    }, false);
+    runSolver("push-relabel", [](FlowNetwork& network, int s, int t) {
+        return PushRelabel(network).maxFlow(s, t);
+    }, false);
+    runSolver("push-relabel, min cut value only", [](FlowNetwork& network, int s, int t) {
+        return PushRelabel(network).minCutValue(s, t);
+    }, false);
+    for (int threads : threadCounts()) {
+        ThreadPool pool(threads);
+        runSolver("parallel push-relabel, " + to_string(threads) + " threads", [&](FlowNetwork& network, int s, int t) {
+            return ParallelPushRelabel(network, pool).maxFlow(s, t);
+        }, false);
+    }
+    runSolver("edmondsKarp", [](FlowNetwork& network, int s, int t) {
+        return (long long)edmondsKarp(network, s, t);
+    }, false);
+    crossCheckSmallFlows(3000, mismatch);
+    if (mismatch)
+        cout << "  MISMATCH between maximum flow solvers\n";
+}
+
+// The adjacency-list flow network layout used before BasicFlowNetwork, kept here only
+// as the baseline of benchmarkFlowNetwork().
+struct LegacyFlowEdge {
+    int u, v;
+    int capacity;
+    int flow;
+    int rev;
+};
+
+// Residual BFS from vertex 1; returns the number of reached vertices.
+template <class Network, class ForEachResidual>
+int residualBfs(const Network& network, ForEachResidual forEachResidual, vector<int>& queue, vector<char>& seen) {
+    fill(seen.begin(), seen.end(), 0);
+    int head = 0, tail = 0;
+    queue[tail++] = 1;
+    seen[1] = 1;
+    while (head < tail) {
+        forEachResidual(network, queue[head++], [&](int v) {
+            if (!seen[v]) {
+                seen[v] = 1;
+                queue[tail++] = v;
+            }
+        });
+    }
+    return tail;
+}
+
+// Compares the memory footprint, build time and traversal time of the old
+// vector<vector<FlowEdge>> layout with the flat network for 32- and 64-bit capacities,
+// and times Dinic on both flat variants.
+void benchmarkFlowNetwork(int vertexCount, int edgeCount, int queries) {
+    cout << "\n[network] " << vertexCount << " vertices, " << edgeCount << " edges, "
+         << queries << " traversals\n";
+    Graph graph = generateBenchmarkGraph(vertexCount, edgeCount, true);
+    int n = vertexCount;
+    vector<int> queue(n + 1);
+    vector<char> seen(n + 1);
+
+    vector<vector<LegacyFlowEdge>> legacy;
+    double ms = measureMs([&] {
+        legacy.assign(n + 1, vector<LegacyFlowEdge>());
+        for (const auto& edge : graph.edges) {
+            int u = get<0>(edge), v = get<1>(edge);
+            legacy[u].push_back({u, v, get<2>(edge), 0, (int)legacy[v].size()});
+            legacy[v].push_back({v, u, 0, 0, (int)legacy[u].size() - 1});
+        }
+    });
+    size_t legacyBytes = legacy.capacity() * sizeof(vector<LegacyFlowEdge>);
+    for (const auto& arcs : legacy)
+        legacyBytes += arcs.capacity() * sizeof(LegacyFlowEdge);
+    printRow("vector<vector<FlowEdge>> build, " + to_string(legacyBytes >> 20) + " MiB", ms, 1);
+
+    BasicFlowNetwork<int> narrow;
+    FlowNetwork wide;
+    ms = measureMs([&] { narrow = buildFlowNetwork<int>(graph); });
+    size_t narrowBytes = (narrow.offsets.size() + narrow.head.size() + narrow.rev.size()) * sizeof(int) +
+                         (narrow.capacity.size() + narrow.residual.size()) * sizeof(int);
+    printRow("flat network<int> build, " + to_string(narrowBytes >> 20) + " MiB", ms, 1);
+    ms = measureMs([&] { wide = buildFlowNetwork(graph); });
+    size_t wideBytes = (wide.offsets.size() + wide.head.size() + wide.rev.size()) * sizeof(int) +
+                       (wide.capacity.size() + wide.residual.size()) * sizeof(long long);
+    printRow("flat network<long long> build, " + to_string(wideBytes >> 20) + " MiB", ms, 1);
+
+    long long reached = 0;
+    ms = measureMs([&] {
+        for (int q = 0; q < queries; q++)
+            reached += residualBfs(legacy, [](const vector<vector<LegacyFlowEdge>>& network, int u, const function<void(int)>& visit) {
+                for (const auto& edge : network[u])
+                    if (edge.capacity - edge.flow > 0)
+                        visit(edge.v);
+            }, queue, seen);
+    });
+    printRow("vector<vector<FlowEdge>> residual BFS", ms, queries);
+    ms = measureMs([&] {
+        for (int q = 0; q < queries; q++)
+            reached -= residualBfs(wide, [](const FlowNetwork& network, int u, const function<void(int)>& visit) {
+                for (int a = network.offsets[u]; a < network.offsets[u + 1]; a++)
+                    if (network.residual[a] > 0)
+                        visit(network.head[a]);
+            }, queue, seen);
+    });
+    printRow("flat network residual BFS", ms, queries);
+
+    long long flowDifference = 0;
+    ms = measureMs([&] { flowDifference += BasicDinic<int>(narrow).maxFlow(1, n); });
+    printRow("dinic, flat network<int>", ms, 1);
+    ms = measureMs([&] { flowDifference -= Dinic(wide).maxFlow(1, n); });
+    printRow("dinic, flat network<long long>", ms, 1);
+    if (reached != 0 || flowDifference != 0)
+        cout << "  MISMATCH between network layouts\n";
+}
+
+// Applies random capacity changes one at a time and re-solves after each, either
+// warm (setCapacity() plus another maxFlow() on the same network) or cold (rebuilding
+// the network and solving from zero flow).
+void benchmarkWarmStart(int vertexCount, int edgeCount, int queries) {
+    cout << "\n[warm] " << vertexCount << " vertices, " << edgeCount << " edges, "
+         << queries << " capacity changes\n";
+    Graph graph = generateBenchmarkGraph(vertexCount, edgeCount, true);
+    FlowNetwork network = buildFlowNetwork(graph);
+    int s = 1, t = vertexCount;
+    mt19937 rng(12345);
+    vector<pair<int, long long>> changes(queries);
+    for (auto& change : changes) {
+        int e = rng() % graph.edges.size();
+        change = {e, (long long)(rng() % 11)};
+    }
+
+    Dinic dinic(network);
+    long long warmValue = 0;
+    double ms = measureMs([&] { warmValue = dinic.maxFlow(s, t); });
+    printRow("initial dinic", ms, 1);
+    vector<long long> warmValues;
+    ms = measureMs([&] {
+        for (const auto& change : changes) {
+            warmValue += dinic.setCapacity(network.edgeArcs[change.first], change.second, s, t);
+            warmValue += dinic.maxFlow(s, t);
+            warmValues.push_back(warmValue);
+        }
+    });
+    printRow("warm: setCapacity + maxFlow", ms, queries);
+
+    bool mismatch = false;
+    ms = measureMs([&] {
+        for (int q = 0; q < queries; q++) {
+            get<2>(graph.edges[changes[q].first]) = (int)changes[q].second;
+            FlowNetwork cold = buildFlowNetwork(graph);
+            mismatch |= Dinic(cold).maxFlow(s, t) != warmValues[q];
+        }
+    });
+    printRow("cold: rebuild + maxFlow", ms, queries);
+    if (mismatch)
+        cout << "  MISMATCH between warm and cold solves\n";
+}
+
+// Compares successive shortest paths with cost scaling for min-cost max-flow with
+// random edge costs in [1, 100], checking that both find the same flow and cost.
+void benchmarkMinCostFlow(int vertexCount, int edgeCount, int queries) {
+    cout << "\n[mincost] " << vertexCount << " vertices, " << edgeCount << " edges, "
+         << queries << " pairs\n";
+    Graph graph = generateBenchmarkGraph(vertexCount, edgeCount, true);
+    mt19937 rng(12345);
+    vector<int> costs(graph.edges.size());
+    for (int& cost : costs)
+        cost = 1 + rng() % 100;
+    FlowNetwork base = buildFlowNetwork(graph, costs);
+    vector<MinCostFlowResult<long long>> expected(queries);
+    bool mismatch = false;
+
+    auto runSolver = [&](const string& name, bool costScaling, bool reference) {
+        double totalMs = 0;
+        for (int q = 0; q < queries; q++) {
+            int s = 1 + (int)((long long)q * 7919 % vertexCount);
+            int t = 1 + (int)((long long)(q + 1) * 104729 % vertexCount);
+            if (t == s)
+                t = s % vertexCount + 1;
+            FlowNetwork network = base;
+            MinCostFlowResult<long long> result;
+            totalMs += measureMs([&] { result = MinCostFlow(network, costScaling).minCostFlow(s, t); });
+            if (reference)
+                expected[q] = result;
+            mismatch |= result.flow != expected[q].flow || result.cost != expected[q].cost;
+        }
+        printRow(name, totalMs, queries);
+    };
+    runSolver("successive shortest paths", false, true);
+    runSolver("cost scaling", true, false);
+
+    // Residual path costs beyond int range: the cheapest path 1 -> 2 -> 3 -> 4 costs
+    // 7e8 but reaches 1.2e9 at vertex 3; 1 -> 5 -> 4 costs 8e8.
+    Graph wide;
+    wide.vertexCount = 5;
+    wide.isDirected = true;
+    wide.edges = {make_tuple(1, 2, 1), make_tuple(2, 3, 1), make_tuple(3, 4, 1), make_tuple(1, 5, 1),
+                  make_tuple(5, 4, 1)};
+    vector<int> wideCosts = {600000000, 600000000, -500000000, 400000000, 400000000};
+    for (bool costScaling : {false, true}) {
+        FlowNetwork network = buildFlowNetwork(wide, wideCosts);
+        MinCostFlowResult<long long> result = MinCostFlow(network, costScaling).minCostFlow(1, 4, 1);
+        mismatch |= result.flow != 1 || result.cost != 700000000;
+    }
+    if (mismatch)
+        cout << "  MISMATCH between min-cost flow solvers\n";
+}
+
+// Compares a fresh network and Dinic run per pair with building a Gomory-Hu tree
+// (n - 1 max-flow calls, for several thread counts) and answering every pair from it.
+// The graph is scaled down by 50 so that the n - 1 flows stay quick.
+void benchmarkGomoryHu(int vertexCount, int edgeCount, int queries) {
+    vertexCount = max(2, vertexCount / 50);
+    edgeCount = max(vertexCount - 1, edgeCount / 50);
+    cout << "\n[gomoryhu] " << vertexCount << " vertices, " << edgeCount << " edges, "
+         << queries << " pairs\n";
+    Graph graph = generateBenchmarkGraph(vertexCount, edgeCount, false);
+    FlowNetwork network = buildFlowNetwork(graph);
+    vector<pair<int, int>> pairs(queries);
+    for (int q = 0; q < queries; q++) {
+        int s = 1 + (int)((long long)q * 7919 % vertexCount);
+        int t = 1 + (int)((long long)(q + 1) * 104729 % vertexCount);
+        pairs[q] = {s, t == s ? s % vertexCount + 1 : t};
+    }
+    vector<long long> expected(queries);
+    double ms = measureMs([&] {
+        for (int q = 0; q < queries; q++) {
+            FlowNetwork fresh = buildFlowNetwork(graph);
+            expected[q] = Dinic(fresh).maxFlow(pairs[q].first, pairs[q].second);
+        }
+    });
+    printRow("rebuild + dinic per pair", ms, queries);
+
+    bool mismatch = false;
+    for (int threads : threadCounts()) {
+        ThreadPool pool(threads);
+        unique_ptr<GomoryHuTree> tree;
+        ms = measureMs([&] { tree.reset(new GomoryHuTree(network, pool)); });
+        printRow("gomory-hu build, " + to_string(threads) + " threads", ms, 1);
+        ms = measureMs([&] {
+            for (int q = 0; q < queries; q++)
+                mismatch |= tree->minCut(pairs[q].first, pairs[q].second) != expected[q];
+        });
+        printRow("gomory-hu query", ms, queries);
+    }
+    if (mismatch)
+        cout << "  MISMATCH between Gomory-Hu tree and Dinic\n";
+}
+
+// Times every generator model with one thread and on pools of several sizes, and
+// checks that the pools produce exactly the single-threaded graph.
+void benchmarkGenerator(int vertexCount, int edgeCount, int) {
+    cout << "\n[generate] " << vertexCount << " vertices, " << edgeCount << " edges\n";
+    const pair<string, GraphModel> models[] = {
+        {"default (connected)", GraphModel::Default},
+        {"erdos-renyi", GraphModel::ErdosRenyi},
+        {"r-mat", GraphModel::RMat},
+        {"grid", GraphModel::Grid},
+    };
+    bool mismatch = false;
+    for (const auto& model : models) {
+        GraphInputs inputs = {
+            vertexCount, vertexCount, false, true, true, false, false, true,
+            0, 10, edgeCount, edgeCount, BENCHMARK_SEED, model.second
+        };
+        Graph reference;
+        double ms = measureMs([&] { reference = GraphGenerator(inputs).generate(); });
+        printRow(model.first + ", sequential", ms, 1);
+        for (int threads : threadCounts()) {
+            ThreadPool pool(threads);
+            Graph graph;
+            ms = measureMs([&] { graph = GraphGenerator(inputs).generate(pool); });
+            printRow(model.first + ", " + to_string(threads) + " threads", ms, 1);
+            mismatch |= graph.edges != reference.edges;
+        }
+    }
+    if (mismatch)
+        cout << "  MISMATCH between sequential and parallel generation\n";
+}
+
+bool sameCsrGraph(const CsrGraph& a, const CsrGraph& b) {
+    return a.vertexCount == b.vertexCount && a.isDirected == b.isDirected &&
+           a.minWeight == b.minWeight && a.maxWeight == b.maxWeight &&
+           a.arcCount() == b.arcCount() &&
+           equal(a.offsets.begin(), a.offsets.end(), b.offsets.begin()) &&
+           equal(a.targets.begin(), a.targets.end(), b.targets.begin()) &&
+           equal(a.weights.begin(), a.weights.end(), b.weights.begin());
+}
+
+// Saves the graph in the binary CSR format and as DIMACS and edge-list text, then
+// times opening the binary file by mmap against copying it into memory, and the
+// parallel text parsers on pools of several sizes, checking that every loader returns
+// the original graph.
+void benchmarkGraphFiles(int vertexCount, int edgeCount, int) {
+    cout << "\n[io] " << vertexCount << " vertices, " << edgeCount << " edges\n";
+    CsrGraph csr = buildCsrGraph(generateBenchmarkGraph(vertexCount, edgeCount, true));
+    const string binaryPath = "benchmark_graph.grcs";
+    const string dimacsPath = "benchmark_graph.gr";
+    const string edgeListPath = "benchmark_graph.txt";
+
+    printRow("saveCsrGraph", measureMs([&] { saveCsrGraph(csr, binaryPath); }), 1);
+    printRow("writeDimacs", measureMs([&] { writeDimacs(csr, dimacsPath); }), 1);
+    printRow("writeEdgeList", measureMs([&] { writeEdgeList(csr, edgeListPath); }), 1);
+
+    bool mismatch = false;
+    CsrGraph mapped;
+    printRow("mapCsrGraph, not validated", measureMs([&] { mapped = mapCsrGraph(binaryPath, false); }), 1);
+    mismatch |= !sameCsrGraph(csr, mapped);
+    printRow("mapCsrGraph", measureMs([&] { mapped = mapCsrGraph(binaryPath); }), 1);
+    vector<int> expected = dijkstra(csr, 1);
+    vector<int> dist;
+    printRow("dijkstra on the mapped graph", measureMs([&] { dist = dijkstra(mapped, 1); }), 1);
+    mismatch |= dist != expected || !sameCsrGraph(csr, mapped);
+    CsrGraph copied;
+    printRow("mapCsrGraph + copy", measureMs([&] {
+        CsrGraph view = mapCsrGraph(binaryPath);
+        copied = view;
+    }), 1);
+    mismatch |= !sameCsrGraph(csr, copied);
+
+    CsrGraph parsed;
+    for (int threads : threadCounts()) {
+        ThreadPool pool(threads);
+        double ms = measureMs([&] { parsed = readDimacs(dimacsPath, pool); });
+        printRow("readDimacs, " + to_string(threads) + " threads", ms, 1);
+        mismatch |= !sameCsrGraph(csr, parsed);
+        ms = measureMs([&] { parsed = readEdgeList(edgeListPath, true, pool); });
+        printRow("readEdgeList, " + to_string(threads) + " threads", ms, 1);
+        mismatch |= !sameCsrGraph(csr, parsed);
+    }
+    remove(binaryPath.c_str());
+    remove(dimacsPath.c_str());
+    remove(edgeListPath.c_str());
+    if (mismatch)
+        cout << "  MISMATCH between the loaded and the original graph\n";
+}
+
+// Runs the instrumented algorithms once without stats and once with TraceStats,
+// prints the counters and phase times of each, and writes all traced phases to
+// benchmark_trace.json for chrome://tracing or Perfetto.
+void benchmarkTrace(int vertexCount, int edgeCount, int) {
+    cout << "\n[trace] " << vertexCount << " vertices, " << edgeCount << " edges\n";
+    Graph graph = generateBenchmarkGraph(vertexCount, edgeCount, false);
+    CsrGraph csr = buildCsrGraph(graph);
+    FlowNetwork network = buildFlowNetwork(csr);
+    int n = csr.vertexCount;
+    TraceStats trace;
+    bool mismatch = false;
+
+    auto run = [&](const string& name, function<long long()> plain, function<long long(TraceStats&)> traced) {
+        long long expected = 0, actual = 0;
+        double plainMs = measureMs([&] { expected = plain(); });
+        TraceStats stats;
+        double tracedMs = measureMs([&] { actual = traced(stats); });
+        traced(trace);
+        printRow(name, plainMs, 1);
+        printRow(name + ", traced", tracedMs, 1);
+        stats.print(cout);
+        mismatch |= expected != actual;
+    };
+    run("bellmanFord", [&] { return (long long)bellmanFord(csr, 1)[n]; },
+        [&](TraceStats& stats) { return (long long)bellmanFord(csr, 1, stats)[n]; });
+    run("dijkstra", [&] { return (long long)dijkstra(csr, 1)[n]; },
+        [&](TraceStats& stats) { return (long long)dijkstra(csr, 1, stats)[n]; });
+    run("kruskal", [&] { return kruskal(graph).first; },
+        [&](TraceStats& stats) { return kruskal(graph, stats).first; });
+    run("edmondsKarp", [&] { network.resetFlow(); return edmondsKarp(network, 1, n); },
+        [&](TraceStats& stats) { network.resetFlow(); return edmondsKarp(network, 1, n, stats); });
+    run("dinic", [&] { network.resetFlow(); return Dinic(network).maxFlow(1, n); },
+        [&](TraceStats& stats) {
+            network.resetFlow();
+            return BasicDinic<long long, TraceStats>(network, stats).maxFlow(1, n);
+        });
+    trace.saveChromeTrace("benchmark_trace.json");
+    cout << "  " << trace.phases().size() << " phases written to benchmark_trace.json\n";
+    if (mismatch)
+        cout << "  MISMATCH between plain and traced runs\n";
+}
+
+// Serves dijkstra(), prim() and edmondsKarp() queries with the plain calls and with
+// one workspace per algorithm, and counts the allocations of the first query, which
+// sizes the workspaces, and of the steady state after it.
+void benchmarkAllocations(int vertexCount, int edgeCount, int queries) {
+    cout << "\n[alloc] " << vertexCount << " vertices, " << edgeCount << " edges, "
+         << queries << " queries\n";
+    CsrGraph csr = buildCsrGraph(generateBenchmarkGraph(vertexCount, edgeCount, false));
+    FlowNetwork network = buildFlowNetwork(csr);
+    int n = csr.vertexCount;
+    DijkstraWorkspace dijkstraWs;
+    PrimWorkspace primWs;
+    EdmondsKarpWorkspace flowWs;
+    long long checksum = 0;
+
+    auto serve = [&](const string& name, function<long long(int)> query) {
+        long long before = allocationCount.load();
+        checksum += query(0);
+        long long first = allocationCount.load() - before;
+        before = allocationCount.load();
+        double ms = measureMs([&] {
+            for (int q = 1; q < queries; q++)
+                checksum += query(q);
+        });
+        long long steady = allocationCount.load() - before;
+        printRow(name, ms, max(1, queries - 1));
+        cout << "    allocations: " << first << " in the first query, "
+             << fixed << setprecision(1) << (double)steady / max(1, queries - 1) << " per query after it\n";
+    };
+    serve("dijkstra", [&](int q) { return (long long)dijkstra(csr, 1 + q % n)[n]; });
+    serve("dijkstra, workspace", [&](int q) {
+        dijkstra(csr, 1 + q % n, dijkstraWs);
+        return -(long long)dijkstraWs.dist[n];
+    });
+    serve("prim", [&](int) { return prim(csr).first; });
+    serve("prim, workspace", [&](int) { return -prim(csr, primWs); });
+    serve("edmondsKarp", [&](int q) {
+        network.resetFlow();
+        return edmondsKarp(network, 1 + q % n, n - q % (n - 1));
+    });
+    serve("edmondsKarp, workspace", [&](int q) {
+        network.resetFlow();
+        return -edmondsKarp(network, 1 + q % n, n - q % (n - 1), flowWs);
+    });
+    if (checksum != 0)
+        cout << "  MISMATCH between plain and workspace results\n";
+}
+
+// Counts the last-level cache misses of this process (user space only) with
+// perf_event_open. Containers and perf_event_paranoid often deny the counter, and
+// then available() is false and the benchmarks print only times.
+class CacheMissCounter {
+  public:
+    CacheMissCounter() : fd(-1) {
+        perf_event_attr attr;
+        memset(&attr, 0, sizeof(attr));
+        attr.size = sizeof(attr);
+        attr.type = PERF_TYPE_HARDWARE;
+        attr.config = PERF_COUNT_HW_CACHE_MISSES;
+        attr.disabled = 1;
+        attr.exclude_kernel = 1;
+        attr.exclude_hv = 1;
+        fd = static_cast<int>(syscall(__NR_perf_event_open, &attr, 0, -1, -1, 0));
+    }
+
+    ~CacheMissCounter() {
+        if (fd >= 0)
+            close(fd);
+    }
+
+    CacheMissCounter(const CacheMissCounter&) = delete;
+    CacheMissCounter& operator=(const CacheMissCounter&) = delete;
+
+    bool available() const {
+        return fd >= 0;
+    }
+
+    // Runs fn and returns the misses it caused, or -1 without a counter.
+    template <class F>
+    long long measure(F fn) {
+        if (fd < 0) {
+            fn();
+            return -1;
+        }
+        ioctl(fd, PERF_EVENT_IOC_RESET, 0);
+        ioctl(fd, PERF_EVENT_IOC_ENABLE, 0);
+        fn();
+        ioctl(fd, PERF_EVENT_IOC_DISABLE, 0);
+        long long misses = 0;
+        if (read(fd, &misses, sizeof(misses)) != sizeof(misses))
+            return -1;
+        return misses;
+    }
+
+  private:
+    int fd;
+};
+
+// Relabels the benchmark graph, a row-major 2-D grid and the same grid with shuffled
+// vertex ids in BFS, reverse Cuthill-McKee and degree order, and times dijkstra() from
+// `queries` sources, bellmanFord() and Dinic on each labelling, with the cache misses
+// of every run where the hardware counter is available. Every relabelled graph must
+// keep the arc count and the degree of each vertex, and the results, translated back
+// to the original ids, must match the original labelling.
+void benchmarkReordering(int vertexCount, int edgeCount, int queries) {
+    int sourceCount = max(1, queries);  // bellmanFord() runs from the first source
+    cout << "\n[reorder] " << vertexCount << " vertices, " << edgeCount << " edges, "
+         << sourceCount << " sources\n";
+    CacheMissCounter counter;
+    if (!counter.available())
+        cout << "  cache-miss counter unavailable (perf_event_open failed), printing times only\n";
+    GraphInputs gridInputs = {
+        vertexCount, vertexCount, false, false, true, false, false, true,
+        0, 10, edgeCount, edgeCount, BENCHMARK_SEED, GraphModel::Grid
+    };
+    Graph grid = GraphGenerator(gridInputs).generate();
+    vector<int> shuffled(grid.vertexCount);
+    iota(shuffled.begin(), shuffled.end(), 1);
+    shuffle(shuffled.begin(), shuffled.end(), mt19937_64(BENCHMARK_SEED));
+    const pair<string, Graph> graphs[] = {
+        {"default", generateBenchmarkGraph(vertexCount, edgeCount, false)},
+        {"grid", grid},
+        {"shuffled grid", relabelGraph(grid, permutationFromOrder(shuffled))},
+    };
+    const pair<string, VertexOrder> orders[] = {
+        {"bfs", VertexOrder::Bfs},
+        {"rcm", VertexOrder::ReverseCuthillMcKee},
+        {"degree", VertexOrder::DegreeSorted},
+    };
+    bool mismatch = false;
+    for (const auto& input : graphs) {
+        CsrGraph original = buildCsrGraph(input.second);
+        int n = original.vertexCount;
+        vector<int> sources;
+        vector<vector<int>> expectedDist;
+        for (int q = 0; q < sourceCount; q++) {
+            sources.push_back(1 + (int)((long long)q * 7919 % n));
+            expectedDist.push_back(dijkstra(original, sources.back()));
+        }
+        long long expectedFlow = -1;
+
+        auto run = [&](const string& label, const CsrGraph& csr, const VertexPermutation* permutation) {
+            auto mapped = [&](int v) { return permutation ? permutation->newId[v] : v; };
+            auto originalIds = [&](const vector<int>& dist) { return permutation ? permutation->toOriginal(dist) : dist; };
+            auto report = [&](const string& name, double ms, long long misses) {
+                cout << "  " << left << setw(36) << input.first + ", " + label + ", " + name << right << setw(12)
+                     << fixed << setprecision(2) << ms << " ms";
+                if (misses >= 0)
+                    cout << setw(16) << misses << " cache misses";
+                cout << "\n";
+            };
+            vector<vector<int>> dist(sourceCount);
+            long long misses = 0;
+            double ms = measureMs([&] {
+                misses = counter.measure([&] {
+                    for (int q = 0; q < sourceCount; q++)
+                        dist[q] = dijkstra(csr, mapped(sources[q]));
+                });
+            });
+            report("dijkstra", ms, misses);
+            for (int q = 0; q < sourceCount; q++)
+                mismatch |= originalIds(dist[q]) != expectedDist[q];
+            ms = measureMs([&] { misses = counter.measure([&] { dist[0] = bellmanFord(csr, mapped(sources[0])); }); });
+            report("bellmanFord", ms, misses);
+            mismatch |= originalIds(dist[0]) != expectedDist[0];
+            FlowNetwork network = buildFlowNetwork(csr);
+            long long flow = 0;
+            ms = measureMs([&] {
+                misses = counter.measure([&] { flow = Dinic(network).maxFlow(mapped(1), mapped(n)); });
+            });
+            report("dinic", ms, misses);
+            if (expectedFlow < 0)
+                expectedFlow = flow;
+            mismatch |= flow != expectedFlow;
+        };
+        run("original", original, nullptr);
+        for (const auto& order : orders) {
+            VertexPermutation permutation;
+            CsrGraph relabelled;
+            double ms = measureMs([&] {
+                permutation = computeVertexOrder(original, order.second);
+                relabelled = relabelCsrGraph(original, permutation);
+            });
+            printRow(input.first + ", " + order.first + ", relabel", ms, 1);
+            mismatch |= relabelled.offsets[n + 1] != original.arcCount();
+            for (int v = 1; v <= n; v++)
+                mismatch |= relabelled.degree(permutation.newId[v]) != original.degree(v);
+            run(order.first, relabelled, &permutation);
+        }
+    }
+    if (mismatch)
+        cout << "  MISMATCH between the relabelled and the original results\n";
+}
+
+// Sizes of the all-pairs benchmark, whose output grows with n^2.
+const int APSP_MAX_VERTICES = 2000;
+const int APSP_DENSE_VERTICES = 1024;
+
+// A directed benchmark graph whose weights w are changed to w + p[u] - p[v] for random
+// potentials p: some arcs become negative, but every cycle keeps its weight, so there
+// is no negative cycle.
+CsrGraph generateNegativeArcGraph(int vertexCount, int edgeCount) {
+    CsrGraph csr = buildCsrGraph(generateBenchmarkGraph(vertexCount, edgeCount, true));
+    mt19937_64 rng(BENCHMARK_SEED);
+    vector<int> potential(csr.vertexCount + 1);
+    for (int& p : potential)
+        p = (int)(rng() % 20);
+    csr.minWeight = INT_MAX;
+    csr.maxWeight = INT_MIN;
+    for (int u = 1; u <= csr.vertexCount; u++) {
+        for (int a = csr.offsets[u]; a < csr.offsets[u + 1]; a++) {
+            csr.weights[a] += potential[u] - potential[csr.targets[a]];
+            csr.minWeight = min(csr.minWeight, (int)csr.weights[a]);
+            csr.maxWeight = max(csr.maxWeight, (int)csr.weights[a]);
+        }
+    }
+    return csr;
+}
+
+// Compares a bellmanFordQueue() run per source with Johnson on pools of several sizes,
+// in memory and with the matrix in a mapped file, on a sparse graph with negative arcs,
+// and Johnson with blocked Floyd-Warshall on a small dense one. The graphs are capped
+// at APSP_MAX_VERTICES and APSP_DENSE_VERTICES vertices. Sampled rows are checked
+// against bellmanFordQueue().
+void benchmarkAllPairs(int vertexCount, int edgeCount, int queries) {
+    int n = min(vertexCount, APSP_MAX_VERTICES);
+    int m = (int)min<long long>((long long)n * max(1, edgeCount / max(1, vertexCount)), (long long)n * (n - 1));
+    int dense = min(n, APSP_DENSE_VERTICES);
+    cout << "\n[apsp] " << n << " vertices, " << m << " edges; dense " << dense << " vertices, "
+         << dense * (dense - 1) / 8 << " edges\n";
+    bool mismatch = false;
+    auto check = [&](const CsrGraph& csr, const BlockedDistanceMatrix& matrix) {
+        for (int q = 0; q < queries; q++) {
+            int s = 1 + (int)((long long)q * 7919 % csr.vertexCount);
+            vector<int> expected = bellmanFordQueue(csr, s).dist;
+            expected[0] = INF;
+            mismatch |= matrix.row(s) != expected;
+        }
+    };
+
+    CsrGraph sparse = generateNegativeArcGraph(n, m);
+    double ms = measureMs([&] {
+        for (int q = 0; q < queries; q++)
+            bellmanFordQueue(sparse, 1 + q % n);
+    });
+    printRow("bellmanFordQueue per source", ms, queries);
+    cout << "    estimated " << fixed << setprecision(2) << ms / queries * n << " ms for all " << n << " sources\n";
+    for (int threads : threadCounts()) {
+        ThreadPool pool(threads);
+        BlockedDistanceMatrix matrix;
+        ms = measureMs([&] { matrix = johnsonAllPairs(sparse, pool); });
+        printRow("johnson, " + to_string(threads) + " threads", ms, 1);
+        check(sparse, matrix);
+    }
+    {
+        ThreadPool pool(threadCounts().back());
+        const string path = "benchmark_distances.grdm";
+        ms = measureMs([&] {
+            BlockedDistanceMatrix matrix(n, path);
+            johnsonAllPairs(sparse, pool, matrix);
+            matrix.sync();
+        });
+        printRow("johnson, mapped file", ms, 1);
+        BlockedDistanceMatrix reopened;
+        printRow("open mapped file", measureMs([&] { reopened = BlockedDistanceMatrix::open(path); }), 1);
+        check(sparse, reopened);
+        remove(path.c_str());
+    }
+
+    CsrGraph denseGraph = generateNegativeArcGraph(dense, dense * (dense - 1) / 8);
+    for (int threads : threadCounts()) {
+        ThreadPool pool(threads);
+        BlockedDistanceMatrix matrix;
+        ms = measureMs([&] { matrix = johnsonAllPairs(denseGraph, pool); });
+        printRow("dense, johnson, " + to_string(threads) + " threads", ms, 1);
+        check(denseGraph, matrix);
+        ms = measureMs([&] { matrix = floydWarshallAllPairs(denseGraph, pool); });
+        printRow("dense, floyd-warshall, " + to_string(threads) + " threads", ms, 1);
+        check(denseGraph, matrix);
+    }
+    if (mismatch)
+        cout << "  MISMATCH between the all-pairs matrix and bellmanFordQueue\n";
+}
+
+// Options of the sweep subcommand:
+//   --sizes 10000,100000      vertex counts
+//   --densities 4,16          edges per vertex
+//   --models default,erdos-renyi,rmat,grid
+//   --warmup 1 --trials 5     untimed and timed runs of each algorithm
+//   --format json|csv --output path   (standard output by default)
+struct SweepOptions {
+    vector<int> sizes = {10000, 100000};
+    vector<int> densities = {4, 16};
+    vector<GraphModel> models = {GraphModel::Default, GraphModel::ErdosRenyi, GraphModel::RMat, GraphModel::Grid};
+    int warmup = 1;
+    int trials = 5;
+    string format = "json";
+    string output;
+};
+
+const pair<const char*, GraphModel> SWEEP_MODELS[] = {
+    {"default", GraphModel::Default},
+    {"erdos-renyi", GraphModel::ErdosRenyi},
+    {"rmat", GraphModel::RMat},
+    {"grid", GraphModel::Grid},
+};
+
+string modelName(GraphModel model) {
+    for (const auto& entry : SWEEP_MODELS) {
+        if (entry.second == model)
+            return entry.first;
+    }
+    return "unknown";
+}
+
+vector<string> splitList(const string& list) {
+    vector<string> items;
+    stringstream stream(list);
+    for (string item; getline(stream, item, ','); ) {
+        if (!item.empty())
+            items.push_back(item);
+    }
+    return items;
+}
+
+int parsePositive(const string& option, const string& value) {
+    char* end = nullptr;
+    long parsed = strtol(value.c_str(), &end, 10);
+    if (value.empty() || *end != '\0' || parsed < 0 || parsed > INT_MAX)
+        throw runtime_error("Invalid value " + value + " for " + option + "!");
+    return static_cast<int>(parsed);
+}
+
+SweepOptions parseSweepOptions(int argc, char** argv) {
+    SweepOptions options;
+    for (int i = 2; i < argc; i += 2) {
+        string option = argv[i];
+        if (i + 1 >= argc)
+            throw runtime_error("Missing value for " + option + "!");
+        string value = argv[i + 1];
+        if (option == "--sizes" || option == "--densities") {
+            vector<int>& list = option == "--sizes" ? options.sizes : options.densities;
+            list.clear();
+            for (const string& item : splitList(value))
+                list.push_back(max(1, parsePositive(option, item)));
+        } else if (option == "--models") {
+            options.models.clear();
+            for (const string& item : splitList(value)) {
+                auto entry = find_if(begin(SWEEP_MODELS), end(SWEEP_MODELS),
+                                     [&](const pair<const char*, GraphModel>& e) { return item == e.first; });
+                if (entry == end(SWEEP_MODELS))
+                    throw runtime_error("Unknown graph model " + item + "!");
+                options.models.push_back(entry->second);
+            }
+        } else if (option == "--warmup") {
+            options.warmup = parsePositive(option, value);
+        } else if (option == "--trials") {
+            options.trials = max(1, parsePositive(option, value));
+        } else if (option == "--format") {
+            if (value != "json" && value != "csv")
+                throw runtime_error("Unknown output format " + value + "!");
+            options.format = value;
+        } else if (option == "--output") {
+            options.output = value;
+        } else {
+            throw runtime_error("Unknown sweep option " + option + "!");
+        }
+    }
+    // The graphs are undirected, so each edge becomes two arcs of the int-indexed CSR
+    // graph.
+    for (int size : options.sizes) {
+        for (int density : options.densities) {
+            if ((long long)size * density > INT_MAX / 2)
+                throw runtime_error("Too many edges for " + to_string(size) + " vertices at density " +
+                                    to_string(density) + "!");
+        }
+    }
+    return options;
+}
+
+// Peak resident set size of the process in KiB. resetPeakRss() restarts it from the
+// current size where the kernel allows it (Linux /proc/self/clear_refs); otherwise
+// the peak covers the whole run so far.
+void resetPeakRss() {
+    ofstream clearRefs("/proc/self/clear_refs");
+    if (clearRefs)
+        clearRefs << "5";
+}
+
+long peakRssKb() {
+    ifstream status("/proc/self/status");
+    for (string line; getline(status, line); ) {
+        if (line.compare(0, 6, "VmHWM:") == 0)
+            return atol(line.c_str() + 6);
+    }
+    struct rusage usage;
+    getrusage(RUSAGE_SELF, &usage);
+    return usage.ru_maxrss;
+}
+
+// Wall time distribution of the timed trials of one algorithm on one graph.
+struct SweepRecord {
+    string model;
+    int vertices;
+    long long edges;
+    string algorithm;
+    int trials;
+    double minMs, medianMs, p90Ms, p99Ms, maxMs, meanMs;
+    double edgesPerSecond;  // input edges over the median time
+    long peakRssKb;         // of the whole process, graph included
+    string check;           // "ok", "mismatch" or "skipped" against the paired algorithm
+};
+
+// Nearest-rank percentile of sorted times.
+double percentile(const vector<double>& sorted, double p) {
+    size_t rank = static_cast<size_t>(ceil(p * sorted.size()));
+    return sorted[min(sorted.size(), max<size_t>(rank, 1)) - 1];
+}
+
+// Runs prepare() and then body() options.warmup + options.trials times, timing only
+// body() of the trials, and returns the timing part of the record.
+template <class Prepare, class Body>
+SweepRecord runTrials(const SweepOptions& options, Prepare prepare, Body body) {
+    resetPeakRss();
+    vector<double> times;
+    for (int run = 0; run < options.warmup + options.trials; run++) {
+        prepare();
+        double ms = measureMs(body);
+        if (run >= options.warmup)
+            times.push_back(ms);
+    }
+    sort(times.begin(), times.end());
+    SweepRecord record = SweepRecord();
+    record.trials = options.trials;
+    record.minMs = times.front();
+    record.maxMs = times.back();
+    size_t k = times.size();
+    record.medianMs = k % 2 ? times[k / 2] : (times[k / 2 - 1] + times[k / 2]) / 2;
+    record.p90Ms = percentile(times, 0.90);
+    record.p99Ms = percentile(times, 0.99);
+    record.meanMs = accumulate(times.begin(), times.end(), 0.0) / k;
+    record.peakRssKb = peakRssKb();
+    return record;
+}
+
+void writeSweepJson(ostream& out, const SweepOptions& options, const vector<SweepRecord>& records) {
+    out << "{\n  \"benchmark\": \"sweep\",\n  \"warmup\": " << options.warmup
+        << ",\n  \"trials\": " << options.trials << ",\n  \"results\": [";
+    for (size_t i = 0; i < records.size(); i++) {
+        const SweepRecord& r = records[i];
+        out << (i ? "," : "") << "\n    {\"model\": \"" << r.model << "\", \"vertices\": " << r.vertices
+            << ", \"edges\": " << r.edges << ", \"algorithm\": \"" << r.algorithm << "\", \"trials\": " << r.trials
+            << fixed << setprecision(3)
+            << ", \"min_ms\": " << r.minMs << ", \"median_ms\": " << r.medianMs << ", \"p90_ms\": " << r.p90Ms
+            << ", \"p99_ms\": " << r.p99Ms << ", \"max_ms\": " << r.maxMs << ", \"mean_ms\": " << r.meanMs
+            << setprecision(0) << ", \"edges_per_second\": " << r.edgesPerSecond
+            << ", \"peak_rss_kb\": " << r.peakRssKb << ", \"check\": \"" << r.check << "\"}";
+    }
+    out << "\n  ]\n}\n";
+}
+
+void writeSweepCsv(ostream& out, const vector<SweepRecord>& records) {
+    out << "model,vertices,edges,algorithm,trials,min_ms,median_ms,p90_ms,p99_ms,max_ms,mean_ms,"
+           "edges_per_second,peak_rss_kb,check\n";
+    for (const SweepRecord& r : records) {
+        out << r.model << ',' << r.vertices << ',' << r.edges << ',' << r.algorithm << ',' << r.trials
+            << fixed << setprecision(3) << ',' << r.minMs << ',' << r.medianMs << ',' << r.p90Ms << ','
+            << r.p99Ms << ',' << r.maxMs << ',' << r.meanMs << setprecision(0) << ',' << r.edgesPerSecond
+            << ',' << r.peakRssKb << ',' << r.check << '\n';
+    }
+}
+
+// Runs bellmanFord, dijkstra, kruskal, prim, edmondsKarp and Dinic on one undirected
+// graph per model, size and density, and cross-checks the pairs: the distances from
+// vertex 1, the spanning tree weight (when the graph is connected, as prim() only
+// spans the component of vertex 1) and the maximum flow from vertex 1 to vertex n.
+// Progress goes to standard error so that the report can be piped.
+void benchmarkSweep(const SweepOptions& options) {
+    vector<SweepRecord> records;
+    for (GraphModel model : options.models) {
+        for (int size : options.sizes) {
+            for (int density : options.densities) {
+                int edges = (int)((long long)size * density);  // bounded by parseSweepOptions()
+                GraphInputs inputs = {
+                    size, size, false, false, true, false, false, false,
+                    0, 10, edges, edges, BENCHMARK_SEED, model
+                };
+                Graph graph = GraphGenerator(inputs).generate();
+                int n = graph.vertexCount;
+                CsrGraph csr = buildCsrGraph(graph);
+                FlowNetwork network = buildFlowNetwork(csr);
+                cerr << "[sweep] " << modelName(model) << ", " << n << " vertices, "
+                     << graph.edges.size() << " edges\n";
+
+                vector<int> bellmanDist, dijkstraDist;
+                pair<long long, vector<tuple<int, int, int>>> kruskalTree, primTree;
+                long long edmondsKarpFlow = 0, dinicFlow = 0;
+                auto nothing = [] {};
+                auto resetFlow = [&] { network.resetFlow(); };
+                vector<pair<string, SweepRecord>> runs;
+                runs.emplace_back("bellmanFord", runTrials(options, nothing, [&] { bellmanDist = bellmanFord(csr, 1); }));
+                runs.emplace_back("dijkstra", runTrials(options, nothing, [&] { dijkstraDist = dijkstra(csr, 1); }));
+                runs.emplace_back("kruskal", runTrials(options, nothing, [&] { kruskalTree = kruskal(graph); }));
+                runs.emplace_back("prim", runTrials(options, nothing, [&] { primTree = prim(csr); }));
+                runs.emplace_back("edmondsKarp", runTrials(options, resetFlow, [&] {
+                    edmondsKarpFlow = edmondsKarp(network, 1, n);
+                }));
+                runs.emplace_back("dinic", runTrials(options, resetFlow, [&] { dinicFlow = Dinic(network).maxFlow(1, n); }));
+
+                bool spanning = kruskalTree.second.size() + 1 == static_cast<size_t>(n);
+                string paths = bellmanDist == dijkstraDist ? "ok" : "mismatch";
+                string tree = !spanning ? "skipped" : kruskalTree.first == primTree.first ? "ok" : "mismatch";
+                string flow = edmondsKarpFlow == dinicFlow ? "ok" : "mismatch";
+                const string checks[] = {paths, paths, tree, tree, flow, flow};
+                for (size_t i = 0; i < runs.size(); i++) {
+                    SweepRecord record = runs[i].second;
+                    record.model = modelName(model);
+                    record.vertices = n;
+                    record.edges = graph.edges.size();
+                    record.algorithm = runs[i].first;
+                    record.edgesPerSecond = record.medianMs > 0 ? record.edges / (record.medianMs / 1000) : 0;
+                    record.check = checks[i];
+                    records.push_back(record);
+                    if (record.check == "mismatch")
+                        cerr << "  MISMATCH: " << record.algorithm << "\n";
+                }
+                if (model == GraphModel::Grid)
+                    break;  // the grid ignores the edge count
+            }
+        }
+    }
+
+    ofstream file;
+    if (!options.output.empty()) {
+        file.open(options.output);
+        if (!file)
+            throw runtime_error("Cannot open " + options.output + " for writing!");
+    }
+    ostream& out = options.output.empty() ? cout : file;
+    if (options.format == "csv")
+        writeSweepCsv(out, records);
+    else
+        writeSweepJson(out, options, records);
+}
+
+// Usage: graph_benchmark [name] [vertexCount] [edgeCount] [queries]
+// where name is one of: all, csr, batch, delta, queues, bellman, p2p, ch, kruskal, boruvka, flow, network, warm, mincost, gomoryhu, generate, io, trace, alloc, reorder, apsp, weights.
+//    or: graph_benchmark sweep [options]   (see SweepOptions)
+int main(int argc, char** argv) {
+    string name = argc > 1 ? argv[1] : "all";
+    int vertexCount = argc > 2 ? atoi(argv[2]) : 100000;
+    int edgeCount = argc > 3 ? atoi(argv[3]) : 1000000;
+    int queries = argc > 4 ? atoi(argv[4]) : 20;
+
+    try {
+        if (name == "sweep") {
+            benchmarkSweep(parseSweepOptions(argc, argv));
+            return 0;
+        }
+        if (name == "all" || name == "csr")
+            benchmarkCsr(vertexCount, edgeCount, queries);
+        if (name == "all" || name == "batch")
+            benchmarkBatch(vertexCount, edgeCount, queries);
+        if (name == "all" || name == "delta")
+            benchmarkDeltaStepping(vertexCount, edgeCount, queries);
+        if (name == "all" || name == "queues")
+            benchmarkQueues(vertexCount, edgeCount, queries);
+        if (name == "all" || name == "bellman")
+            benchmarkBellmanFord(vertexCount, edgeCount, queries);
+        if (name == "all" || name == "p2p")
+            benchmarkPointToPoint(vertexCount, edgeCount, queries);
+        if (name == "all" || name == "ch")
+            benchmarkContractionHierarchy(vertexCount, edgeCount, queries);
+        if (name == "all" || name == "kruskal")
+            benchmarkKruskal(vertexCount, edgeCount, queries);
+        if (name == "all" || name == "boruvka")
+            benchmarkBoruvka(vertexCount, edgeCount, queries);
+        if (name == "all" || name == "flow")
+            benchmarkMaxFlow(vertexCount, edgeCount, queries);
+        if (name == "all" || name == "network")
+            benchmarkFlowNetwork(vertexCount, edgeCount, queries);
+        if (name == "all" || name == "warm")
+            benchmarkWarmStart(vertexCount, edgeCount, queries);
+        if (name == "all" || name == "mincost")
+            benchmarkMinCostFlow(vertexCount, edgeCount, queries);
+        if (name == "all" || name == "gomoryhu")
+            benchmarkGomoryHu(vertexCount, edgeCount, queries);
+        if (name == "all" || name == "generate")
+            benchmarkGenerator(vertexCount, edgeCount, queries);
+        if (name == "all" || name == "io")
+            benchmarkGraphFiles(vertexCount, edgeCount, queries);
+        if (name == "all" || name == "trace")
+            benchmarkTrace(vertexCount, edgeCount, queries);
+        if (name == "all" || name == "alloc")
+            benchmarkAllocations(vertexCount, edgeCount, queries);
+        if (name == "all" || name == "reorder")
+            benchmarkReordering(vertexCount, edgeCount, queries);
+        if (name == "all" || name == "apsp")
+            benchmarkAllPairs(vertexCount, edgeCount, queries);
+        if (name == "all" || name == "weights")
+            benchmarkWeightTypes(vertexCount, edgeCount, queries);
+    } catch (const runtime_error& e) {
+        cerr << "Error: " << e.what() << "\n";
+        return 1;
+    }
+    return 0;
+}
@@ -31,7 +31,7 @@ void activateDijkstra(Graph& graph, int starting_point) {
 
 void activateKruskal(Graph& graph) {
     auto result = kruskal(graph);
-    int totalWeight = result.first;
+    long long totalWeight = result.first;
     vector<tuple<int, int, int>> mstEdges = result.second;
 
     cout << "\nKruskal's MST total weight: " << totalWeight << "\n";
@@ -43,7 +43,7 @@ void activateKruskal(Graph& graph) {
 
 void activatePrim(Graph& graph) {
     auto result = prim(graph);
-    int totalWeight = result.first;
+    long long totalWeight = result.first;
     vector<tuple<int, int, int>> mstEdges = result.second;
 
     cout << "\nPrim's MST total weight: " << totalWeight << "\n";
@@ -55,14 +55,14 @@ void activatePrim(Graph& graph) {
 
 void activateFordFulkerson(Graph& graph, int source, int sink) {
     auto network = buildFlowNetwork(graph);
-    int maxFlow = edmondsKarp(network, source, sink);
+    long long maxFlow = edmondsKarp(network, source, sink);
     cout << "\n(Edmonds Karp) Maximum flow from vertex " << source << " to vertex " << sink << " is: " << maxFlow << "\n";
 }
 
 void activateDinic(Graph& graph, int source, int sink) {
     auto network = buildFlowNetwork(graph);
     Dinic dinic(network);
-    int maxFlow = dinic.maxFlow(source, sink);
+    long long maxFlow = dinic.maxFlow(source, sink);
     cout << "\n(Dinic) Maximum flow from vertex " << source << " to vertex " << sink << " is: " << maxFlow << "\n";
 }
 
@@ -80,7 +80,9 @@ int main() {
         0,  // minEdgeWeight (allows negative weights)
         10,   // maxEdgeWeight
         5,    // minEdgeCount
-        15     // maxEdgeCount
+        15,    // maxEdgeCount
+        0,     // seed (0 seeds from the clock)
+        GraphModel::Default // model
     };
 
     try {